@@ -0,0 +1,86 @@
+/*
+ * Aptos SDK for ESP32 - Benchmark Example
+ *
+ * Measures the SDK's CPU hot paths on the device and prints one JSON
+ * object per benchmark on Serial (see BenchmarkSuite.h), e.g.
+ *
+ *   {"benchmark":"signMessage/256","iterations":512,"ns_per_op":...}
+ *
+ * The transferCoin round trip runs only when WiFi credentials and a node
+ * URL are set below; the sender must be funded on that node.
+ *
+ * Allocation counts need a malloc hook. With PlatformIO add:
+ *
+ *   build_flags = -DAPTOS_BENCH_WRAP_MALLOC
+ *       -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc
+ *
+ * Without it allocs_per_op and bytes_per_op are reported as -1.
+ */
+
+#include <WiFi.h>
+
+#ifdef APTOS_BENCH_WRAP_MALLOC
+#define APTOS_BENCH_HAS_ALLOC_HOOK 1
+#endif
+
+#include "BenchmarkSuite.h"
+
+#ifdef APTOS_BENCH_WRAP_MALLOC
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    aptosBenchRecordAlloc(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    aptosBenchRecordAlloc(count * size);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    aptosBenchRecordAlloc(size);
+    return __real_realloc(ptr, size);
+}
+}
+#endif
+
+// WiFi credentials, leave empty to skip the network benchmark
+const char* ssid = "";
+const char* password = "";
+
+// Node and funded sender used by transferCoin/round_trip
+const char* nodeUrl = APTOS_TESTNET;
+const char* senderPrivateKey = "";
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    bool online = false;
+    if (strlen(ssid) > 0) {
+        WiFi.begin(ssid, password);
+        unsigned long start = millis();
+        while (WiFi.status() != WL_CONNECTED && millis() - start < 20000) {
+            delay(250);
+        }
+        online = WiFi.status() == WL_CONNECTED;
+    }
+
+    AptosBenchConfig config;
+    config.minTimeMs = 1000;
+    config.nodeUrl = (online && strlen(senderPrivateKey) > 0) ? nodeUrl : nullptr;
+    config.privateKeyHex = senderPrivateKey;
+    config.filter = nullptr;
+    config.table = false;
+
+    int failures = runAptosBenchmarks(Serial, config);
+    Serial.printf("{\"done\":true,\"failures\":%d}\n", failures);
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,338 @@
+/*
+ * Aptos SDK - micro-benchmark suite
+ *
+ * Shared by the Benchmark sketch and the host runner
+ * (extras/benchmark/sdk_bench.cpp). Each case is run in growing batches
+ * until one batch takes at least minTimeMs; that batch is reported as one
+ * JSON object per line:
+ *
+ *   {"benchmark":"bytesToHex/32","iterations":262144,"ns_per_op":412.3,
+ *    "allocs_per_op":2.00,"bytes_per_op":96.0}
+ *
+ * Allocation figures come from a malloc hook provided by the program that
+ * includes this file (define APTOS_BENCH_HAS_ALLOC_HOOK and call
+ * aptosBenchRecordAlloc() from it). Without a hook they are reported as -1.
+ */
+
+#ifndef APTOS_BENCHMARK_SUITE_H
+#define APTOS_BENCHMARK_SUITE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <AptosSDK.h>
+
+#ifndef APTOS_BENCH_HAS_ALLOC_HOOK
+#define APTOS_BENCH_HAS_ALLOC_HOOK 0
+#endif
+
+#ifdef ESP32
+#define APTOS_BENCH_PLATFORM "esp32"
+#else
+#define APTOS_BENCH_PLATFORM "host"
+#endif
+
+// Upper bound for one batch, so a case that never reaches minTimeMs ends
+#define APTOS_BENCH_MAX_ITERATIONS 100000000UL
+
+struct AptosBenchConfig
+{
+    uint32_t minTimeMs;        // Minimum duration of the measured batch
+    const char *nodeUrl;       // Node for the transferCoin case, nullptr skips it
+    const char *privateKeyHex; // Funded sender for transferCoin, nullptr = random key
+    const char *filter;        // Only run cases whose name contains this, nullptr = all
+    bool table;                // Human-readable table instead of JSON lines
+};
+
+struct AptosBenchResult
+{
+    const char *name;
+    uint32_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+};
+
+// Counters bumped by the allocation hook while a batch is being measured
+static volatile bool aptosBenchCounting = false;
+static volatile uint32_t aptosBenchAllocCount = 0;
+static volatile uint64_t aptosBenchAllocBytes = 0;
+
+static inline void aptosBenchRecordAlloc(size_t size)
+{
+    if (aptosBenchCounting)
+    {
+        aptosBenchAllocCount = aptosBenchAllocCount + 1;
+        aptosBenchAllocBytes = aptosBenchAllocBytes + size;
+    }
+}
+
+typedef bool (*AptosBenchFn)(void *context);
+
+static bool aptosBenchMeasure(const char *name, AptosBenchFn fn, void *context,
+                              const AptosBenchConfig &config, AptosBenchResult &result)
+{
+    // Warm-up call: lazily built tables and caches are not part of the cost
+    if (!fn(context))
+    {
+        return false;
+    }
+
+    uint64_t target = (uint64_t)config.minTimeMs * 1000;
+    uint32_t iterations = 1;
+    while (true)
+    {
+        aptosBenchAllocCount = 0;
+        aptosBenchAllocBytes = 0;
+        aptosBenchCounting = true;
+        unsigned long start = micros();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            if (!fn(context))
+            {
+                aptosBenchCounting = false;
+                return false;
+            }
+        }
+        unsigned long elapsed = micros() - start;
+        aptosBenchCounting = false;
+
+        if (elapsed >= target || iterations >= APTOS_BENCH_MAX_ITERATIONS)
+        {
+            result.name = name;
+            result.iterations = iterations;
+            result.nsPerOp = (double)elapsed * 1000.0 / iterations;
+            result.allocsPerOp = APTOS_BENCH_HAS_ALLOC_HOOK ? (double)aptosBenchAllocCount / iterations : -1;
+            result.bytesPerOp = APTOS_BENCH_HAS_ALLOC_HOOK ? (double)aptosBenchAllocBytes / iterations : -1;
+            return true;
+        }
+
+        // Aim 20% past the target, growing at least 2x and at most 100x per step
+        uint64_t next = elapsed > 0 ? (uint64_t)iterations * target * 6 / 5 / elapsed : (uint64_t)iterations * 100;
+        if (next < (uint64_t)iterations * 2)
+        {
+            next = (uint64_t)iterations * 2;
+        }
+        if (next > (uint64_t)iterations * 100)
+        {
+            next = (uint64_t)iterations * 100;
+        }
+        iterations = next > APTOS_BENCH_MAX_ITERATIONS ? APTOS_BENCH_MAX_ITERATIONS : (uint32_t)next;
+    }
+}
+
+static void aptosBenchReport(Print &out, const AptosBenchConfig &config, const AptosBenchResult &r)
+{
+    if (config.table)
+    {
+        out.printf("%-38s %10lu %14.1f %10.2f %12.1f\n", r.name, (unsigned long)r.iterations,
+                   r.nsPerOp, r.allocsPerOp, r.bytesPerOp);
+        return;
+    }
+    out.printf("{\"benchmark\":\"%s\",\"iterations\":%lu,\"ns_per_op\":%.1f,"
+               "\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f}\n",
+               r.name, (unsigned long)r.iterations, r.nsPerOp, r.allocsPerOp, r.bytesPerOp);
+}
+
+// ---------------------------------------------------------------------------
+// Cases
+// ---------------------------------------------------------------------------
+
+struct AptosBenchData
+{
+    uint8_t bytes[256];
+    uint8_t decoded[32];
+    uint8_t signature[64];
+    String hex32;
+    String shortAddress;
+    String recipient;
+    AccountAddress recipientAddress;
+    JsonDocument vector;
+    AptosAccount account;
+    AptosTransactionTemplate transfer;
+    AptosSDK *sdk;
+    uint64_t sink;
+};
+
+static bool aptosBenchBytesToHex(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    String hex = AptosUtils::bytesToHex(d.bytes, 32);
+    d.sink += hex.length();
+    return true;
+}
+
+static bool aptosBenchHexToBytes(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    return AptosUtils::hexToBytes(d.hex32, d.decoded, sizeof(d.decoded));
+}
+
+static bool aptosBenchPadHexAddress(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    String padded = AptosUtils::padHexAddress(d.shortAddress);
+    d.sink += padded.length();
+    return true;
+}
+
+static bool aptosBenchParseAddress(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    AccountAddress address;
+    if (!address.parse(d.recipient))
+    {
+        return false;
+    }
+    d.sink += address.data()[0];
+    return true;
+}
+
+static bool aptosBenchSerializeVector(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    String encoded = AptosUtils::serializeVector(d.vector.as<JsonArray>());
+    d.sink += encoded.length();
+    return !encoded.isEmpty();
+}
+
+static bool aptosBenchSha256(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    String digest = AptosUtils::sha256Hash(d.bytes, sizeof(d.bytes));
+    d.sink += digest.length();
+    return true;
+}
+
+static bool aptosBenchSignMessage(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    return d.account.signMessage(d.bytes, sizeof(d.bytes), d.signature);
+}
+
+static bool aptosBenchTransactionBuild(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    AptosTransaction txn = AptosTransaction::createCoinTransfer(
+        d.account.getAddress(), d.recipient, 1000, d.sink & 0xFFFF);
+    d.sink++;
+    return txn.build();
+}
+
+static bool aptosBenchTemplatePatch(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    d.transfer.patch(d.recipientAddress, 1000, d.sink & 0xFFFF, 1700000000);
+    d.sink++;
+    return d.transfer.isValid();
+}
+
+static bool aptosBenchTransferCoin(void *context)
+{
+    AptosBenchData &d = *(AptosBenchData *)context;
+    uint64_t txnHash = 0;
+    return d.sdk->transferCoin(d.account, d.recipient, 1, txnHash);
+}
+
+static bool aptosBenchSelected(const AptosBenchConfig &config, const char *name)
+{
+    return config.filter == nullptr || strstr(name, config.filter) != nullptr;
+}
+
+// Runs every case and prints one result per line. Returns the number of
+// cases that failed.
+static int runAptosBenchmarks(Print &out, const AptosBenchConfig &config)
+{
+    AptosBenchData *data = new AptosBenchData();
+    AptosBenchData &d = *data;
+    for (size_t i = 0; i < sizeof(d.bytes); i++)
+    {
+        d.bytes[i] = (uint8_t)(i * 131 + 7);
+    }
+    d.hex32 = AptosUtils::bytesToHex(d.bytes, 32);
+    d.shortAddress = "0x1";
+    d.recipient = "0x2d3a64f5f5b4b4f8c4d7f1a8f7c1a3e5b2c9d0e1f2a3b4c5d6e7f8091a2b3c4d";
+    d.vector.add("0x1");
+    d.vector.add(42);
+    d.vector.add("aptos");
+    d.vector.add(1000000);
+    d.sdk = nullptr;
+    d.sink = 0;
+
+    bool haveKey = config.privateKeyHex != nullptr && config.privateKeyHex[0] != '\0';
+    if (!(haveKey ? d.account.fromPrivateKey(config.privateKeyHex) : d.account.createRandom()))
+    {
+        out.println("{\"error\":\"account setup failed\"}");
+        delete data;
+        return 1;
+    }
+    d.recipientAddress.parse(d.recipient);
+    d.transfer.coinTransfer(d.account.getAccountAddress(), 4);
+
+    struct Case
+    {
+        const char *name;
+        AptosBenchFn fn;
+        bool network;
+    };
+    const Case cases[] = {
+        {"bytesToHex/32", aptosBenchBytesToHex, false},
+        {"hexToBytes/32", aptosBenchHexToBytes, false},
+        {"padHexAddress/0x1", aptosBenchPadHexAddress, false},
+        {"AccountAddress::parse/64", aptosBenchParseAddress, false},
+        {"serializeVector/4", aptosBenchSerializeVector, false},
+        {"sha256Hash/256", aptosBenchSha256, false},
+        {"signMessage/256", aptosBenchSignMessage, false},
+        {"AptosTransaction::build/coin_transfer", aptosBenchTransactionBuild, false},
+        {"AptosTransactionTemplate::patch", aptosBenchTemplatePatch, false},
+        {"transferCoin/round_trip", aptosBenchTransferCoin, true},
+    };
+
+    if (config.table)
+    {
+        out.printf("%-38s %10s %14s %10s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op", "B/op");
+    }
+    else
+    {
+        out.printf("{\"suite\":\"esp32-aptos-sdk\",\"platform\":\"%s\",\"min_time_ms\":%lu,\"alloc_hook\":%s}\n",
+                   APTOS_BENCH_PLATFORM, (unsigned long)config.minTimeMs,
+                   APTOS_BENCH_HAS_ALLOC_HOOK ? "true" : "false");
+    }
+
+    int failures = 0;
+    for (const Case &c : cases)
+    {
+        if (!aptosBenchSelected(config, c.name))
+        {
+            continue;
+        }
+        if (c.network)
+        {
+            if (config.nodeUrl == nullptr || config.nodeUrl[0] == '\0')
+            {
+                continue;
+            }
+            if (d.sdk == nullptr)
+            {
+                d.sdk = new AptosSDK(config.nodeUrl);
+                d.sdk->setSubmitMode(APTOS_SUBMIT_BCS);
+            }
+        }
+
+        AptosBenchResult result;
+        if (aptosBenchMeasure(c.name, c.fn, &d, config, result))
+        {
+            aptosBenchReport(out, config, result);
+        }
+        else
+        {
+            failures++;
+            out.printf(config.table ? "%-38s FAILED\n" : "{\"benchmark\":\"%s\",\"error\":\"failed\"}\n", c.name);
+        }
+    }
+
+    delete d.sdk;
+    delete data;
+    return failures;
+}
+
+#endif
@@ -0,0 +1,142 @@
+// Host benchmark for AptosEd25519 signing.
+//
+// Usage: ed25519_bench [iterations] [message_bytes]
+//
+// Reports signatures/sec and per-signature latency for signing with a cached
+// expanded key (what AptosAccount does) and, for comparison, re-expanding the
+// seed before every signature.
+#include <Arduino.h>
+#include "AptosEd25519.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+typedef std::chrono::steady_clock BenchClock;
+
+// RFC 8032 section 7.1, TEST 1
+static const uint8_t RFC8032_SEED[32] = {
+    0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4,
+    0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60
+};
+
+static const uint8_t RFC8032_PUBLIC_KEY[32] = {
+    0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+    0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a
+};
+
+static const uint8_t RFC8032_SIGNATURE[64] = {
+    0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+    0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+    0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+    0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b
+};
+
+static bool selfTest() {
+    uint8_t scalar[ED25519_SCALAR_SIZE];
+    uint8_t prefix[32];
+    uint8_t publicKey[ED25519_PUBLIC_KEY_SIZE];
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+
+    AptosEd25519::expandSecret(RFC8032_SEED, scalar, prefix);
+    AptosEd25519::publicKeyFromScalar(scalar, publicKey);
+    if (memcmp(publicKey, RFC8032_PUBLIC_KEY, sizeof(publicKey)) != 0) {
+        printf("self-test: public key mismatch\n");
+        return false;
+    }
+
+    AptosEd25519::sign(scalar, prefix, publicKey, nullptr, 0, nullptr, 0, signature);
+    if (memcmp(signature, RFC8032_SIGNATURE, sizeof(signature)) != 0) {
+        printf("self-test: signature mismatch\n");
+        return false;
+    }
+
+    if (!AptosEd25519::verify(publicKey, nullptr, 0, nullptr, 0, signature)) {
+        printf("self-test: verification failed\n");
+        return false;
+    }
+    return true;
+}
+
+static void report(const char* name, std::vector<double>& latenciesUs) {
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    double total = 0;
+    for (double us : latenciesUs) {
+        total += us;
+    }
+    size_t n = latenciesUs.size();
+    double mean = total / n;
+    printf("%-28s %8zu %12.1f %10.2f %10.2f %10.2f %10.2f\n",
+           name, n, 1e6 / mean, mean, latenciesUs[n / 2], latenciesUs[(n * 99) / 100], latenciesUs[n - 1]);
+}
+
+template <typename Fn>
+static void run(const char* name, int iterations, Fn fn) {
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(iterations);
+
+    // Warm up (also builds the base point table)
+    for (int i = 0; i < 16; i++) {
+        fn(i);
+    }
+
+    for (int i = 0; i < iterations; i++) {
+        BenchClock::time_point start = BenchClock::now();
+        fn(i);
+        latenciesUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - start).count());
+    }
+    report(name, latenciesUs);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    size_t messageBytes = argc > 2 ? (size_t)atoi(argv[2]) : 256;
+    if (iterations <= 0) iterations = 2000;
+
+    if (!selfTest()) {
+        return 1;
+    }
+
+    std::vector<uint8_t> message(messageBytes);
+    for (size_t i = 0; i < messageBytes; i++) {
+        message[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    uint8_t seed[ED25519_SEED_SIZE];
+    for (int i = 0; i < ED25519_SEED_SIZE; i++) {
+        seed[i] = (uint8_t)(i + 1);
+    }
+
+    uint8_t scalar[ED25519_SCALAR_SIZE];
+    uint8_t prefix[32];
+    uint8_t publicKey[ED25519_PUBLIC_KEY_SIZE];
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    AptosEd25519::expandSecret(seed, scalar, prefix);
+    AptosEd25519::publicKeyFromScalar(scalar, publicKey);
+
+    printf("message: %zu bytes, iterations: %d\n", messageBytes, iterations);
+    printf("%-28s %8s %12s %10s %10s %10s %10s\n",
+           "benchmark", "n", "ops/sec", "mean_us", "p50_us", "p99_us", "max_us");
+
+    run("sign_cached_key", iterations, [&](int i) {
+        message[0] = (uint8_t)i;
+        AptosEd25519::sign(scalar, prefix, publicKey, nullptr, 0, message.data(), message.size(), signature);
+    });
+
+    run("sign_expand_each_time", iterations, [&](int i) {
+        uint8_t s[ED25519_SCALAR_SIZE], p[32], pk[ED25519_PUBLIC_KEY_SIZE];
+        message[0] = (uint8_t)i;
+        AptosEd25519::expandSecret(seed, s, p);
+        AptosEd25519::publicKeyFromScalar(s, pk);
+        AptosEd25519::sign(s, p, pk, nullptr, 0, message.data(), message.size(), signature);
+    });
+
+    run("verify", iterations / 4 > 0 ? iterations / 4 : 1, [&](int) {
+        if (!AptosEd25519::verify(publicKey, nullptr, 0, message.data(), message.size(), signature)) {
+            printf("verify failed\n");
+            exit(1);
+        }
+    });
+
+    return 0;
+}
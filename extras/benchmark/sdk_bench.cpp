@@ -0,0 +1,71 @@
+// Host runner for the SDK micro-benchmark suite (examples/Benchmark).
+//
+// Usage: sdk_bench [--table] [--min-time-ms N] [--node URL] [--key HEX] [--filter TEXT]
+//
+// Prints one JSON object per benchmark (or a table with --table). The
+// transferCoin round trip runs only with --node; against the mock node
+// use --commit-delay-ms 0 so every iteration sees the previous one
+// committed.
+//
+// Allocations are counted by interposing malloc/calloc/realloc over glibc.
+// They reflect the host shims: the shim String is std::string-based, so
+// String-heavy paths allocate differently than on the device.
+#define APTOS_BENCH_HAS_ALLOC_HOOK 1
+#include "BenchmarkSuite.h"
+
+#include <stdlib.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+    aptosBenchRecordAlloc(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    aptosBenchRecordAlloc(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    aptosBenchRecordAlloc(size);
+    return __libc_realloc(ptr, size);
+}
+}
+
+static void usage() {
+    Serial.println("usage: sdk_bench [--table] [--min-time-ms N] [--node URL] [--key HEX] [--filter TEXT]");
+}
+
+int main(int argc, char** argv) {
+    AptosBenchConfig config;
+    config.minTimeMs = 200;
+    config.nodeUrl = nullptr;
+    config.privateKeyHex = nullptr;
+    config.filter = nullptr;
+    config.table = false;
+
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--table") {
+            config.table = true;
+        } else if (arg == "--min-time-ms" && hasValue) {
+            config.minTimeMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--node" && hasValue) {
+            config.nodeUrl = argv[++i];
+        } else if (arg == "--key" && hasValue) {
+            config.privateKeyHex = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            config.filter = argv[++i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    return runAptosBenchmarks(Serial, config) == 0 ? 0 : 1;
+}
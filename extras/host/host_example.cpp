@@ -0,0 +1,86 @@
+/*
+ * Aptos SDK - host example
+ *
+ * Runs the SDK on Linux against a REST node reachable over plain HTTP,
+ * normally the mock node in extras/host/mock_node:
+ *
+ *   python3 extras/host/mock_node/mock_node.py --port 8080 &
+ *   ./build/aptos_host_example http://127.0.0.1:8080/v1
+ *
+ * 1. Read ledger info
+ * 2. Generate a sender and a recipient account
+ * 3. Check balances
+ * 4. Transfer APT (BCS submission) and wait for it to commit
+ */
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "AptosSDK.h"
+#include "AptosAccount.h"
+
+static bool waitForSequenceNumber(AptosSDK& aptos, const String& address, uint64_t expected,
+                                  unsigned long timeoutMs) {
+    unsigned long start = millis();
+    while (millis() - start < timeoutMs) {
+        JsonDocument account;
+        if (aptos.getAccount(address, account, 0, AptosSDK::responseFilter(APTOS_FILTER_ACCOUNT)) &&
+            AptosUtils::getJsonUint64(account, "sequence_number", 0) >= expected) {
+            return true;
+        }
+        delay(100);
+    }
+    return false;
+}
+
+static void printBalance(AptosSDK& aptos, const char* label, const String& address) {
+    uint64_t balance = 0;
+    if (aptos.getAccountBalanceSimple(address, balance)) {
+        Serial.printf("%s balance: %llu octas\n", label, (unsigned long long)balance);
+    } else {
+        Serial.printf("%s balance: unavailable (%s)\n", label, aptos.getLastError().c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    String nodeUrl = argc > 1 ? argv[1] : "http://127.0.0.1:8080/v1";
+    bool debug = argc > 2 && String(argv[2]) == "--debug";
+
+    AptosSDK aptos(nodeUrl);
+    aptos.setDebugMode(debug);
+    aptos.setSubmitMode(APTOS_SUBMIT_BCS);
+
+    JsonDocument ledger;
+    if (!aptos.getLedgerInfo(ledger, AptosSDK::responseFilter(APTOS_FILTER_LEDGER_INFO))) {
+        Serial.printf("Cannot reach %s (%s)\n", nodeUrl.c_str(), aptos.getLastError().c_str());
+        return 1;
+    }
+    Serial.printf("Chain id %d, ledger version %s\n", ledger["chain_id"].as<int>(),
+                  ledger["ledger_version"].as<String>().c_str());
+
+    AptosAccount sender;
+    AptosAccount recipient;
+    if (!sender.createRandom() || !recipient.createRandom()) {
+        Serial.println("Key generation failed");
+        return 1;
+    }
+    Serial.printf("Sender:    %s\n", sender.getAddress().c_str());
+    Serial.printf("Recipient: %s\n", recipient.getAddress().c_str());
+
+    printBalance(aptos, "Sender", sender.getAddress());
+
+    uint64_t txnHash = 0;
+    if (!aptos.transferCoin(sender, recipient.getAddress(), 1000000, txnHash)) {
+        Serial.printf("Transfer failed (%s)\n", aptos.getLastError().c_str());
+        return 1;
+    }
+
+    if (!waitForSequenceNumber(aptos, sender.getAddress(), 1, 10000)) {
+        Serial.println("Transfer did not commit in time");
+        return 1;
+    }
+    Serial.println("Transfer committed");
+
+    printBalance(aptos, "Sender", sender.getAddress());
+    printBalance(aptos, "Recipient", recipient.getAddress());
+    return 0;
+}
@@ -0,0 +1,705 @@
+#!/usr/bin/env python3
+"""Local stand-in for an Aptos fullnode REST API (/v1), for host builds.
+
+Serves the endpoints AptosSDK talks to, over plain HTTP, with an in-memory
+ledger: accounts are funded on first use, submitted transactions (JSON or
+BCS) are validated for sequence number, chain id and expiration, held as
+pending for --commit-delay-ms and then committed in sequence-number order.
+Coin transfers move balances and emit deposit/withdraw events.
+
+Signatures are NOT verified, and hashes of JSON submissions are not the
+real Aptos hashes; BCS submissions are hashed exactly like a real node.
+
+    python3 extras/host/mock_node/mock_node.py --port 8080
+    ./build/aptos_host_example http://127.0.0.1:8080/v1
+"""
+
+import argparse
+import hashlib
+import json
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, unquote, urlparse
+
+CONTENT_TYPE_JSON = "application/json"
+CONTENT_TYPE_BCS = "application/x.aptos.signed_transaction+bcs"
+
+APT_COIN = "0x1::aptos_coin::AptosCoin"
+COIN_STORE = "0x1::coin::CoinStore<%s>" % APT_COIN
+TRANSFER_FUNCTIONS = ("0x1::aptos_account::transfer", "0x1::coin::transfer",
+                      "0x1::aptos_account::transfer_coins")
+
+# Creation numbers of the legacy CoinStore event handles
+DEPOSIT_EVENTS = 2
+WITHDRAW_EVENTS = 3
+
+# Subset of move_core_types::vm_status::StatusCode used by the validator
+SEQUENCE_NUMBER_TOO_OLD = 3
+SEQUENCE_NUMBER_TOO_NEW = 4
+INSUFFICIENT_BALANCE_FOR_TRANSACTION_FEE = 5
+TRANSACTION_EXPIRED = 6
+BAD_CHAIN_ID = 16
+
+STATUS_NAMES = {
+    SEQUENCE_NUMBER_TOO_OLD: "SEQUENCE_NUMBER_TOO_OLD",
+    SEQUENCE_NUMBER_TOO_NEW: "SEQUENCE_NUMBER_TOO_NEW",
+    INSUFFICIENT_BALANCE_FOR_TRANSACTION_FEE: "INSUFFICIENT_BALANCE_FOR_TRANSACTION_FEE",
+    TRANSACTION_EXPIRED: "TRANSACTION_EXPIRED",
+    BAD_CHAIN_ID: "BAD_CHAIN_ID",
+}
+
+# Mempool parks transactions at most this far ahead of the account
+MAX_SEQUENCE_GAP = 100
+GAS_USED = 10
+TRANSACTION_PREFIX = hashlib.sha3_256(b"APTOS::Transaction").digest()
+
+
+class ApiError(Exception):
+    def __init__(self, status, error_code, message, vm_error_code=None):
+        Exception.__init__(self, message)
+        self.status = status
+        self.body = {"message": message, "error_code": error_code,
+                     "vm_error_code": vm_error_code}
+
+
+def vm_error(code):
+    return ApiError(400, "vm_error", "Invalid transaction: Type: Validation Code: %s"
+                    % STATUS_NAMES[code], code)
+
+
+def normalize_address(addr):
+    addr = addr.lower()
+    if addr.startswith("0x"):
+        addr = addr[2:]
+    if not addr or len(addr) > 64 or any(c not in "0123456789abcdef" for c in addr):
+        raise ApiError(400, "invalid_input", "Invalid account address: %s" % addr)
+    return "0x" + addr.rjust(64, "0")
+
+
+# ---------------------------------------------------------------------------
+# BCS decoding of SignedTransaction
+# ---------------------------------------------------------------------------
+
+class BcsReader:
+    def __init__(self, data, pos=0):
+        self.data = data
+        self.pos = pos
+
+    def take(self, n):
+        if self.pos + n > len(self.data):
+            raise ApiError(400, "invalid_input", "Truncated BCS transaction")
+        out = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return out
+
+    def u8(self):
+        return self.take(1)[0]
+
+    def u64(self):
+        return int.from_bytes(self.take(8), "little")
+
+    def uleb(self):
+        value, shift = 0, 0
+        while True:
+            b = self.u8()
+            value |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return value
+            shift += 7
+
+    def bytes(self):
+        return self.take(self.uleb())
+
+    def string(self):
+        return self.bytes().decode()
+
+    def address(self):
+        return "0x" + self.take(32).hex()
+
+    def type_tag(self):
+        tag = self.uleb()
+        simple = {0: "bool", 1: "u8", 2: "u64", 3: "u128", 4: "address",
+                  5: "signer", 8: "u16", 9: "u32", 10: "u256"}
+        if tag in simple:
+            return simple[tag]
+        if tag == 6:
+            return "vector<%s>" % self.type_tag()
+        if tag == 7:
+            addr, module, name = self.address(), self.string(), self.string()
+            args = [self.type_tag() for _ in range(self.uleb())]
+            short = "0x" + (addr[2:].lstrip("0") or "0")
+            return "%s::%s::%s%s" % (short, module, name,
+                                     "<%s>" % ", ".join(args) if args else "")
+        raise ApiError(400, "invalid_input", "Unsupported type tag %d" % tag)
+
+
+def decode_signed_transaction(reader):
+    """Decodes one SignedTransaction; returns (txn dict, raw bytes)."""
+    start = reader.pos
+    sender = reader.address()
+    sequence_number = reader.u64()
+
+    variant = reader.uleb()
+    if variant != 2:
+        raise ApiError(400, "invalid_input", "Only entry function payloads are supported")
+    module_addr = reader.address()
+    module = reader.string()
+    function = reader.string()
+    type_args = [reader.type_tag() for _ in range(reader.uleb())]
+    args = [reader.bytes() for _ in range(reader.uleb())]
+
+    max_gas = reader.u64()
+    gas_price = reader.u64()
+    expiration = reader.u64()
+    chain_id = reader.u8()
+
+    auth = reader.uleb()
+    if auth != 0:
+        raise ApiError(400, "invalid_input", "Only Ed25519 authenticators are supported")
+    public_key = reader.bytes()
+    signature = reader.bytes()
+
+    raw = reader.data[start:reader.pos]
+    short = "0x" + (module_addr[2:].lstrip("0") or "0")
+    txn = {
+        "sender": sender,
+        "sequence_number": sequence_number,
+        "max_gas_amount": max_gas,
+        "gas_unit_price": gas_price,
+        "expiration_timestamp_secs": expiration,
+        "chain_id": chain_id,
+        "function": "%s::%s::%s" % (short, module, function),
+        "type_arguments": type_args,
+        "raw_arguments": args,
+        "signature": {"type": "ed25519_signature",
+                      "public_key": "0x" + public_key.hex(),
+                      "signature": "0x" + signature.hex()},
+        "hash": "0x" + hashlib.sha3_256(TRANSACTION_PREFIX + b"\x00" + raw).hexdigest(),
+    }
+    return txn
+
+
+def decode_json_transaction(body):
+    payload = body.get("payload") or {}
+    args = payload.get("arguments") or []
+    txn = {
+        "sender": body.get("sender", ""),
+        "sequence_number": int(body.get("sequence_number", 0)),
+        "max_gas_amount": int(body.get("max_gas_amount", 0)),
+        "gas_unit_price": int(body.get("gas_unit_price", 0)),
+        "expiration_timestamp_secs": int(body.get("expiration_timestamp_secs", 0)),
+        "chain_id": None,
+        "function": payload.get("function", ""),
+        "type_arguments": payload.get("type_arguments") or [],
+        "json_arguments": args,
+        "signature": body.get("signature"),
+    }
+    canonical = json.dumps(body, sort_keys=True, separators=(",", ":")).encode()
+    txn["hash"] = "0x" + hashlib.sha3_256(TRANSACTION_PREFIX + b"\x01" + canonical).hexdigest()
+    return txn
+
+
+def transfer_arguments(txn):
+    """Returns (recipient, amount) of a coin transfer, or None."""
+    if txn["function"] not in TRANSFER_FUNCTIONS:
+        return None
+    if "raw_arguments" in txn:
+        args = txn["raw_arguments"]
+        if len(args) != 2 or len(args[0]) != 32 or len(args[1]) != 8:
+            return None
+        return "0x" + args[0].hex(), int.from_bytes(args[1], "little")
+    args = txn["json_arguments"]
+    if len(args) != 2:
+        return None
+    return normalize_address(str(args[0])), int(args[1])
+
+
+# ---------------------------------------------------------------------------
+# Ledger
+# ---------------------------------------------------------------------------
+
+class Ledger:
+    def __init__(self, args):
+        self.lock = threading.Condition()
+        self.chain_id = args.chain_id
+        self.commit_delay = args.commit_delay_ms / 1000.0
+        self.initial_balance = args.initial_balance
+        self.strict_accounts = args.strict_accounts
+        self.genesis_usec = int(time.time() * 1e6)
+        self.version = 0
+        self.block_height = 0
+        self.accounts = {}
+        self.committed = []     # user transactions in version order
+        self.by_hash = {}       # hash -> transaction (pending or committed)
+        self.pending = {}       # sender -> {sequence_number: transaction}
+        self.events = {}        # (address, creation_number) -> [event]
+
+    # Callers hold self.lock for everything below
+
+    def account(self, address, create=True):
+        address = normalize_address(address)
+        acct = self.accounts.get(address)
+        if acct is None:
+            if not create or self.strict_accounts:
+                raise ApiError(404, "account_not_found",
+                               "Account not found by Address(%s)" % address)
+            acct = {"sequence_number": 0, "balance": self.initial_balance,
+                    "authentication_key": address}
+            self.accounts[address] = acct
+        return acct
+
+    def ledger_info(self):
+        return {
+            "chain_id": self.chain_id,
+            "epoch": "1",
+            "ledger_version": str(self.version),
+            "oldest_ledger_version": "0",
+            "ledger_timestamp": str(self.timestamp_usec()),
+            "node_role": "full_node",
+            "oldest_block_height": "0",
+            "block_height": str(self.block_height),
+            "git_hash": "mock",
+        }
+
+    def timestamp_usec(self):
+        return max(self.genesis_usec, int(time.time() * 1e6))
+
+    def submit(self, txn):
+        if txn["chain_id"] is not None and txn["chain_id"] != self.chain_id:
+            raise vm_error(BAD_CHAIN_ID)
+        if txn["expiration_timestamp_secs"] and txn["expiration_timestamp_secs"] < time.time():
+            raise vm_error(TRANSACTION_EXPIRED)
+
+        existing = self.by_hash.get(txn["hash"])
+        if existing is not None:
+            return existing
+
+        acct = self.account(txn["sender"])
+        sender = normalize_address(txn["sender"])
+        seq = txn["sequence_number"]
+        parked = self.pending.setdefault(sender, {})
+        if seq < acct["sequence_number"] or seq in parked:
+            raise vm_error(SEQUENCE_NUMBER_TOO_OLD)
+        if seq >= acct["sequence_number"] + MAX_SEQUENCE_GAP:
+            raise vm_error(SEQUENCE_NUMBER_TOO_NEW)
+        if acct["balance"] < txn["max_gas_amount"] * txn["gas_unit_price"]:
+            raise vm_error(INSUFFICIENT_BALANCE_FOR_TRANSACTION_FEE)
+
+        txn["sender"] = sender
+        txn["submitted_at"] = time.time()
+        txn["state"] = "pending"
+        parked[seq] = txn
+        self.by_hash[txn["hash"]] = txn
+        return txn
+
+    def advance(self):
+        """Commits every pending transaction whose delay has elapsed."""
+        now = time.time()
+        progressed = False
+        for sender, parked in self.pending.items():
+            acct = self.accounts[sender]
+            while True:
+                txn = parked.get(acct["sequence_number"])
+                if txn is None or now - txn["submitted_at"] < self.commit_delay:
+                    break
+                del parked[acct["sequence_number"]]
+                self.execute(txn, acct)
+                progressed = True
+        if progressed:
+            self.lock.notify_all()
+
+    def execute(self, txn, acct):
+        self.version += 1
+        self.block_height += 1
+        fee = GAS_USED * txn["gas_unit_price"]
+        success, vm_status = True, "Executed successfully"
+
+        transfer = transfer_arguments(txn)
+        if transfer is not None:
+            recipient, amount = transfer
+            if acct["balance"] < amount + fee:
+                success = False
+                vm_status = ("Move abort in 0x1::coin: EINSUFFICIENT_BALANCE(0x10006): "
+                             "Not enough coins to complete transaction")
+            else:
+                acct["balance"] -= amount
+                self.account(recipient, create=True)["balance"] += amount
+                self.emit(txn["sender"], WITHDRAW_EVENTS, "0x1::coin::WithdrawEvent", amount)
+                self.emit(recipient, DEPOSIT_EVENTS, "0x1::coin::DepositEvent", amount)
+
+        acct["balance"] -= min(fee, acct["balance"])
+        acct["sequence_number"] += 1
+        txn.update({"state": "committed", "version": self.version, "success": success,
+                    "vm_status": vm_status, "gas_used": GAS_USED,
+                    "timestamp": self.timestamp_usec()})
+        self.committed.append(txn)
+
+    def emit(self, address, creation_number, type_name, amount):
+        events = self.events.setdefault((normalize_address(address), creation_number), [])
+        events.append({
+            "version": str(self.version),
+            "guid": {"creation_number": str(creation_number),
+                     "account_address": normalize_address(address)},
+            "sequence_number": str(len(events)),
+            "type": type_name,
+            "data": {"amount": str(amount)},
+        })
+
+    def render(self, txn):
+        """JSON shape of a transaction as returned by /transactions/*."""
+        out = {
+            "hash": txn["hash"],
+            "sender": txn["sender"],
+            "sequence_number": str(txn["sequence_number"]),
+            "max_gas_amount": str(txn["max_gas_amount"]),
+            "gas_unit_price": str(txn["gas_unit_price"]),
+            "expiration_timestamp_secs": str(txn["expiration_timestamp_secs"]),
+            "payload": {"type": "entry_function_payload", "function": txn["function"],
+                        "type_arguments": txn["type_arguments"],
+                        "arguments": self.render_arguments(txn)},
+            "signature": txn["signature"],
+        }
+        if txn["state"] == "pending":
+            out["type"] = "pending_transaction"
+            return out
+        out.update({
+            "type": "user_transaction",
+            "version": str(txn["version"]),
+            "success": txn["success"],
+            "vm_status": txn["vm_status"],
+            "gas_used": str(txn["gas_used"]),
+            "timestamp": str(txn["timestamp"]),
+            "events": [],
+            "changes": [],
+        })
+        return out
+
+    @staticmethod
+    def render_arguments(txn):
+        if "json_arguments" in txn:
+            return txn["json_arguments"]
+        transfer = transfer_arguments(txn)
+        if transfer is not None:
+            return [transfer[0], str(transfer[1])]
+        return ["0x" + a.hex() for a in txn["raw_arguments"]]
+
+    def resources(self, address):
+        acct = self.account(address)
+        address = normalize_address(address)
+
+        def handle(creation_number):
+            count = len(self.events.get((address, creation_number), []))
+            return {"counter": str(count),
+                    "guid": {"id": {"addr": address, "creation_num": str(creation_number)}}}
+
+        return [
+            {"type": "0x1::account::Account", "data": {
+                "authentication_key": acct["authentication_key"],
+                "sequence_number": str(acct["sequence_number"]),
+                "guid_creation_num": "4",
+                "coin_register_events": {"counter": "0", "guid": {"id": {
+                    "addr": address, "creation_num": "0"}}},
+            }},
+            {"type": COIN_STORE, "data": {
+                "coin": {"value": str(acct["balance"])},
+                "frozen": False,
+                "deposit_events": handle(DEPOSIT_EVENTS),
+                "withdraw_events": handle(WITHDRAW_EVENTS),
+            }},
+        ]
+
+
+# ---------------------------------------------------------------------------
+# HTTP front end
+# ---------------------------------------------------------------------------
+
+def page(items, query, default_limit=25):
+    start = int(query.get("start", ["0"])[0] or 0)
+    limit = int(query.get("limit", [str(default_limit)])[0] or default_limit)
+    return items[start:start + limit]
+
+
+def cursor_page(items, query, default_limit=1000):
+    """Page addressed by an opaque cursor, as for resources and modules.
+
+    Returns the page and the headers; X-Aptos-Cursor is only sent while
+    more items follow."""
+    cursor = query.get("start", [""])[0]
+    start = int(cursor[2:], 16) if cursor.startswith("0x") else 0
+    limit = int(query.get("limit", [str(default_limit)])[0] or default_limit)
+    headers = {}
+    if start + limit < len(items):
+        headers["X-Aptos-Cursor"] = "0x%016x" % (start + limit)
+    return items[start:start + limit], headers
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    server_version = "AptosMockNode/1.0"
+    ledger = None
+    options = None
+
+    def log_message(self, fmt, *args):
+        if not self.options.quiet:
+            BaseHTTPRequestHandler.log_message(self, fmt, *args)
+
+    def do_GET(self):
+        self.dispatch("GET")
+
+    def do_POST(self):
+        self.dispatch("POST")
+
+    def dispatch(self, method):
+        url = urlparse(self.path)
+        query = parse_qs(url.query)
+        length = int(self.headers.get("Content-Length") or 0)
+        body = self.rfile.read(length) if length else b""
+
+        if self.options.latency_ms:
+            time.sleep(self.options.latency_ms / 1000.0)
+        if self.options.slow_rate and random.random() < self.options.slow_rate:
+            time.sleep(self.options.slow_ms / 1000.0)
+        if self.options.fail_rate and random.random() < self.options.fail_rate:
+            self.reply(503, {"message": "Service unavailable (injected)",
+                             "error_code": "internal_error", "vm_error_code": None})
+            return
+
+        path = url.path.rstrip("/")
+        if not path.startswith("/v1"):
+            self.reply(404, {"message": "Not found", "error_code": "web_framework_error",
+                             "vm_error_code": None})
+            return
+        parts = [unquote(p) for p in path[3:].split("/") if p]
+
+        try:
+            with self.ledger.lock:
+                self.ledger.advance()
+                status, result, headers = self.route(method, parts, query, body)
+        except ApiError as e:
+            self.log_message("%s", e.body["message"])
+            status, result, headers = e.status, e.body, {}
+        except (ValueError, KeyError, UnicodeDecodeError) as e:
+            status, result, headers = 400, {"message": "Invalid request: %s" % e,
+                                            "error_code": "invalid_input",
+                                            "vm_error_code": None}, {}
+        self.reply(status, result, headers)
+
+    def route(self, method, parts, query, body):
+        ledger = self.ledger
+        n = len(parts)
+
+        if method == "GET":
+            if n == 0:
+                return 200, ledger.ledger_info(), {}
+            if parts == ["-", "healthy"]:
+                return 200, {"message": "aptos-node:ok"}, {}
+            if parts in (["spec"], ["spec.yaml"], ["spec.json"]):
+                return 200, {"openapi": "3.0.0", "info": {"title": "Aptos Node API (mock)"}}, {}
+            if parts == ["estimate_gas_price"]:
+                price = self.options.gas_price
+                return 200, {"deprioritized_gas_estimate": price, "gas_estimate": price,
+                             "prioritized_gas_estimate": price * 3 // 2}, {}
+            if n == 3 and parts[0] == "blocks" and parts[1] in ("by_height", "by_version"):
+                height = int(parts[2])
+                if parts[1] == "by_version":
+                    height = min(height, ledger.block_height)
+                if height > ledger.block_height:
+                    raise ApiError(404, "block_not_found", "Block not found: %d" % height)
+                return 200, {"block_height": str(height), "block_hash": "0x" + hashlib.sha3_256(
+                    str(height).encode()).hexdigest(), "block_timestamp": str(ledger.timestamp_usec()),
+                    "first_version": str(height), "last_version": str(height)}, {}
+            if parts[0] == "accounts" and n >= 2:
+                return self.get_account(parts, query)
+            if parts == ["transactions"]:
+                # Versions start at 1; start addresses them, not positions
+                start = int(query.get("start", ["0"])[0] or 0)
+                txns = page(ledger.committed, {"start": [str(max(start - 1, 0))],
+                                               "limit": query.get("limit", ["25"])})
+                return 200, [ledger.render(t) for t in txns], {}
+            if n == 3 and parts[:2] in (["transactions", "by_hash"], ["transactions", "wait_by_hash"]):
+                txn = ledger.by_hash.get(parts[2].lower())
+                if txn is not None and parts[1] == "wait_by_hash":
+                    deadline = time.time() + self.options.wait_timeout_ms / 1000.0
+                    while txn["state"] == "pending" and time.time() < deadline:
+                        ledger.lock.wait(0.02)
+                        ledger.advance()
+                if txn is None:
+                    raise ApiError(404, "transaction_not_found",
+                                   "Transaction not found by Transaction hash(%s)" % parts[2])
+                return (202 if txn["state"] == "pending" else 200), ledger.render(txn), {}
+            if n == 3 and parts[:2] == ["transactions", "by_version"]:
+                version = int(parts[2])
+                if version < 1 or version > len(ledger.committed):
+                    raise ApiError(404, "transaction_not_found",
+                                   "Transaction not found by Ledger version(%d)" % version)
+                return 200, ledger.render(ledger.committed[version - 1]), {}
+            if n == 2 and parts[0] == "events":
+                return 200, [], {}
+
+        if method == "POST":
+            if parts == ["transactions"]:
+                txn = ledger.submit(self.decode_one(body))
+                return 202, ledger.render(txn), {}
+            if parts == ["transactions", "batch"]:
+                return self.post_batch(body)
+            if parts == ["transactions", "simulate"]:
+                decoded = self.decode_one(body)
+                return 200, [{"success": True, "vm_status": "Executed successfully",
+                              "gas_used": str(GAS_USED),
+                              "gas_unit_price": str(decoded["gas_unit_price"] or self.options.gas_price),
+                              "max_gas_amount": str(decoded["max_gas_amount"]),
+                              "sequence_number": str(decoded["sequence_number"]),
+                              "sender": decoded["sender"], "hash": decoded["hash"]}], {}
+            if parts == ["view"]:
+                return 200, self.view(json.loads(body)), {}
+            if n == 3 and parts[0] == "tables" and parts[2] in ("item", "raw_item"):
+                raise ApiError(404, "table_item_not_found", "Table item not found")
+
+        raise ApiError(404, "web_framework_error", "Not found: %s /v1/%s" % (method, "/".join(parts)))
+
+    def get_account(self, parts, query):
+        ledger = self.ledger
+        address = parts[1]
+        n = len(parts)
+        if n == 2:
+            acct = ledger.account(address)
+            return 200, {"sequence_number": str(acct["sequence_number"]),
+                         "authentication_key": acct["authentication_key"]}, {}
+        if n == 3 and parts[2] == "resources":
+            resources, headers = cursor_page(ledger.resources(address), query)
+            return 200, resources, headers
+        if n >= 4 and parts[2] == "resource":
+            wanted = "/".join(parts[3:]).replace(" ", "")
+            for res in ledger.resources(address):
+                if res["type"].replace(" ", "") == wanted:
+                    return 200, res, {}
+            raise ApiError(404, "resource_not_found", "Resource not found: %s" % wanted)
+        if n >= 4 and parts[2] == "balance":
+            return 200, ledger.account(address)["balance"], {}
+        if n == 3 and parts[2] == "modules":
+            return 200, [], {}
+        if n == 4 and parts[2] == "module":
+            raise ApiError(404, "module_not_found", "Module not found: %s" % parts[3])
+        if n == 3 and parts[2] == "transactions":
+            sender = normalize_address(address)
+            mine = [t for t in ledger.committed if t["sender"] == sender]
+            return 200, [ledger.render(t) for t in page(mine, query)], {}
+        if n >= 4 and parts[2] == "events":
+            key = parts[3]
+            if key.isdigit():
+                creation_number = int(key)
+            else:
+                field = parts[4] if n > 4 else key
+                creation_number = WITHDRAW_EVENTS if "withdraw" in field else DEPOSIT_EVENTS
+            events = ledger.events.get((normalize_address(address), creation_number), [])
+            return 200, page(events, query), {}
+        raise ApiError(404, "web_framework_error", "Not found: /v1/%s" % "/".join(parts))
+
+    def decode_one(self, body):
+        if self.headers.get("Content-Type", "").startswith(CONTENT_TYPE_BCS):
+            reader = BcsReader(body)
+            txn = decode_signed_transaction(reader)
+            if reader.pos != len(body):
+                raise ApiError(400, "invalid_input", "Trailing bytes after BCS transaction")
+            return txn
+        return decode_json_transaction(json.loads(body))
+
+    def post_batch(self, body):
+        if self.headers.get("Content-Type", "").startswith(CONTENT_TYPE_BCS):
+            reader = BcsReader(body)
+            count = reader.uleb()
+            decoded = [decode_signed_transaction(reader) for _ in range(count)]
+        else:
+            decoded = [decode_json_transaction(t) for t in json.loads(body)]
+
+        failures = []
+        for index, txn in enumerate(decoded):
+            try:
+                self.ledger.submit(txn)
+            except ApiError as e:
+                failures.append({"error": e.body, "transaction_index": index})
+        return (202 if not failures else 206), {"transaction_failures": failures}, {}
+
+    def view(self, request):
+        function = request.get("function", "")
+        args = request.get("arguments") or []
+        if function == "0x1::coin::balance" and args:
+            return [str(self.ledger.account(args[0])["balance"])]
+        if function == "0x1::account::get_sequence_number" and args:
+            return [str(self.ledger.account(args[0])["sequence_number"])]
+        if function == "0x1::chain_id::get":
+            return [self.ledger.chain_id]
+        raise ApiError(400, "invalid_input", "View function not supported by mock: %s" % function)
+
+    def reply(self, status, result, headers=None):
+        payload = json.dumps(result).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", CONTENT_TYPE_JSON)
+        info = self.ledger.ledger_info()
+        self.send_header("X-Aptos-Chain-Id", str(info["chain_id"]))
+        self.send_header("X-Aptos-Ledger-Version", info["ledger_version"])
+        self.send_header("X-Aptos-Ledger-Oldest-Version", info["oldest_ledger_version"])
+        self.send_header("X-Aptos-Ledger-TimestampUsec", info["ledger_timestamp"])
+        self.send_header("X-Aptos-Epoch", info["epoch"])
+        self.send_header("X-Aptos-Block-Height", info["block_height"])
+        self.send_header("X-Aptos-Oldest-Block-Height", info["oldest_block_height"])
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+
+        if self.options.chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+            self.end_headers()
+            step = max(1, self.options.chunk_size)
+            for i in range(0, len(payload), step):
+                piece = payload[i:i + step]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(piece), piece))
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.send_header("Content-Length", str(len(payload)))
+            self.end_headers()
+            self.wfile.write(payload)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--chain-id", type=int, default=4)
+    parser.add_argument("--gas-price", type=int, default=100)
+    parser.add_argument("--initial-balance", type=int, default=100000000,
+                        help="octas given to an account on first use")
+    parser.add_argument("--strict-accounts", action="store_true",
+                        help="return account_not_found instead of auto-funding")
+    parser.add_argument("--commit-delay-ms", type=int, default=200,
+                        help="time a transaction stays pending before it commits")
+    parser.add_argument("--wait-timeout-ms", type=int, default=1000,
+                        help="how long wait_by_hash holds a pending transaction")
+    parser.add_argument("--latency-ms", type=int, default=0,
+                        help="delay added before every response")
+    parser.add_argument("--slow-rate", type=float, default=0.0,
+                        help="fraction of requests delayed by an extra --slow-ms")
+    parser.add_argument("--slow-ms", type=int, default=1000)
+    parser.add_argument("--fail-rate", type=float, default=0.0,
+                        help="fraction of requests answered with 503")
+    parser.add_argument("--chunked", action="store_true",
+                        help="send bodies with chunked transfer encoding")
+    parser.add_argument("--chunk-size", type=int, default=256)
+    parser.add_argument("--quiet", action="store_true")
+    args = parser.parse_args()
+
+    Handler.ledger = Ledger(args)
+    Handler.options = args
+    server = ThreadingHTTPServer((args.host, args.port), Handler)
+    server.daemon_threads = True
+    print("Aptos mock node on http://%s:%d/v1 (chain id %d)"
+          % (args.host, server.server_address[1], args.chain_id), flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+static const char* eepromFile() {
+    const char* path = getenv("APTOS_HOST_EEPROM_FILE");
+    return path ? path : "eeprom.bin";
+}
+
+EEPROMClass::EEPROMClass() : data(nullptr), size(0), dirty(false) {
+}
+
+EEPROMClass::~EEPROMClass() {
+    end();
+}
+
+bool EEPROMClass::begin(size_t newSize) {
+    if (data && size == newSize) return true;
+    end();
+
+    data = (uint8_t*)malloc(newSize);
+    if (!data) return false;
+    memset(data, 0xFF, newSize);
+    size = newSize;
+
+    FILE* f = fopen(eepromFile(), "rb");
+    if (f) {
+        size_t n = fread(data, 1, size, f);
+        (void)n;
+        fclose(f);
+    }
+    return true;
+}
+
+uint8_t EEPROMClass::read(int address) {
+    if (!data || address < 0 || (size_t)address >= size) return 0;
+    return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (!data || address < 0 || (size_t)address >= size) return;
+    if (data[address] != value) {
+        data[address] = value;
+        dirty = true;
+    }
+}
+
+bool EEPROMClass::commit() {
+    if (!data) return false;
+    if (!dirty) return true;
+
+    FILE* f = fopen(eepromFile(), "wb");
+    if (!f) return false;
+    size_t n = fwrite(data, 1, size, f);
+    fclose(f);
+    dirty = false;
+    return n == size;
+}
+
+void EEPROMClass::end() {
+    if (data) {
+        commit();
+        free(data);
+        data = nullptr;
+        size = 0;
+    }
+}
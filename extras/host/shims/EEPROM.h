@@ -0,0 +1,40 @@
+// Host shim: EEPROM emulation backed by a file (APTOS_HOST_EEPROM_FILE,
+// default "eeprom.bin" in the working directory).
+#ifndef APTOS_HOST_EEPROM_H
+#define APTOS_HOST_EEPROM_H
+
+#include <Arduino.h>
+
+class EEPROMClass {
+private:
+    uint8_t* data;
+    size_t size;
+    bool dirty;
+
+public:
+    EEPROMClass();
+    ~EEPROMClass();
+
+    bool begin(size_t size);
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    bool commit();
+    void end();
+    size_t length() { return size; }
+
+    template <typename T>
+    T& get(int address, T& value) {
+        for (size_t i = 0; i < sizeof(T); i++) ((uint8_t*)&value)[i] = read(address + i);
+        return value;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& value) {
+        for (size_t i = 0; i < sizeof(T); i++) write(address + i, ((const uint8_t*)&value)[i]);
+        return value;
+    }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,287 @@
+#include "HTTPClient.h"
+
+HTTPClient::HTTPClient()
+    : port(80), urlValid(false), timeoutMs(HTTPCLIENT_DEFAULT_TCP_TIMEOUT),
+      connectTimeoutMs(HTTPCLIENT_DEFAULT_TCP_TIMEOUT), reuse(true), http10(false),
+      contentLength(-1), chunked(false), lastError(0) {
+}
+
+HTTPClient::~HTTPClient() {
+    end();
+}
+
+bool HTTPClient::begin(const String& url) {
+    requestHeaders.clear();
+    responseHeaders.clear();
+    urlValid = false;
+
+    if (!url.startsWith("http://")) {
+        // TLS is not provided by the host shim; point the SDK at a plain-HTTP node
+        lastError = HTTPC_ERROR_CONNECTION_REFUSED;
+        return false;
+    }
+
+    String rest = url.substring(7);
+    int slash = rest.indexOf('/');
+    String authority = slash < 0 ? rest : rest.substring(0, slash);
+    path = slash < 0 ? String("/") : rest.substring(slash);
+
+    int colon = authority.indexOf(':');
+    if (colon >= 0) {
+        host = authority.substring(0, colon);
+        port = (uint16_t)authority.substring(colon + 1).toInt();
+    } else {
+        host = authority;
+        port = 80;
+    }
+
+    urlValid = !host.isEmpty();
+    return urlValid;
+}
+
+void HTTPClient::end() {
+    client.stop();
+}
+
+void HTTPClient::setReuse(bool reuse) {
+    this->reuse = reuse;
+}
+
+void HTTPClient::setTimeout(uint16_t timeout) {
+    timeoutMs = timeout;
+    client.setTimeout(timeout);
+}
+
+void HTTPClient::setConnectTimeout(int32_t timeout) {
+    // As on the ESP32: bounds connect() only, setTimeout() covers the rest
+    connectTimeoutMs = timeout;
+}
+
+void HTTPClient::useHTTP10(bool usehttp10) {
+    http10 = usehttp10;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value) {
+    for (auto& h : requestHeaders) {
+        if (h.name.equalsIgnoreCase(name)) {
+            h.value = value;
+            return;
+        }
+    }
+    requestHeaders.push_back({name, value});
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    collectKeys.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        collectKeys.push_back(headerKeys[i]);
+    }
+}
+
+String HTTPClient::header(const char* name) {
+    for (auto& h : responseHeaders) {
+        if (h.name.equalsIgnoreCase(name)) return h.value;
+    }
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+    for (auto& h : responseHeaders) {
+        if (h.name.equalsIgnoreCase(name)) return true;
+    }
+    return false;
+}
+
+int HTTPClient::GET() {
+    return sendRequest("GET");
+}
+
+int HTTPClient::POST(uint8_t* payload, size_t size) {
+    return sendRequest("POST", payload, size);
+}
+
+int HTTPClient::POST(const String& payload) {
+    return sendRequest("POST", (uint8_t*)payload.c_str(), payload.length());
+}
+
+int HTTPClient::sendHeader(const char* type, size_t size, bool hasBody) {
+    if (!urlValid) {
+        return lastError ? lastError : HTTPC_ERROR_NOT_CONNECTED;
+    }
+
+    // One connection per request; the node closes it after the response
+    client.stop();
+    client.setTimeout(timeoutMs);
+    if (!client.connect(host.c_str(), port, connectTimeoutMs)) {
+        lastError = HTTPC_ERROR_CONNECTION_REFUSED;
+        return lastError;
+    }
+
+    String request = String(type) + " " + path + (http10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+    request += "Host: " + host + "\r\n";
+    request += "User-Agent: ESP32HTTPClient\r\n";
+    request += "Connection: close\r\n";
+    if (hasBody || strcmp(type, "POST") == 0) {
+        request += "Content-Length: " + String((unsigned long)size) + "\r\n";
+    }
+    for (auto& h : requestHeaders) {
+        request += h.name + ": " + h.value + "\r\n";
+    }
+    request += "\r\n";
+
+    if (client.write((const uint8_t*)request.c_str(), request.length()) != request.length()) {
+        lastError = HTTPC_ERROR_SEND_HEADER_FAILED;
+        return lastError;
+    }
+    return 0;
+}
+
+int HTTPClient::sendRequest(const char* type, uint8_t* payload, size_t size) {
+    int error = sendHeader(type, size, payload != nullptr);
+    if (error < 0) {
+        return error;
+    }
+
+    if (size > 0 && client.write(payload, size) != size) {
+        lastError = HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+        return lastError;
+    }
+
+    return handleHeaderResponse();
+}
+
+int HTTPClient::sendRequest(const char* type, Stream* stream, size_t size) {
+    int error = sendHeader(type, size, stream != nullptr);
+    if (error < 0) {
+        return error;
+    }
+
+    // Copied through a small buffer like the ESP32 client does
+    uint8_t buffer[1460];
+    size_t sent = 0;
+    while (stream != nullptr && sent < size) {
+        size_t want = size - sent < sizeof(buffer) ? size - sent : sizeof(buffer);
+        size_t got = stream->readBytes(buffer, want);
+        if (got == 0 || client.write(buffer, got) != got) {
+            lastError = HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+            return lastError;
+        }
+        sent += got;
+    }
+
+    return handleHeaderResponse();
+}
+
+String HTTPClient::readLine() {
+    String line;
+    char c;
+    while (client.readBytes(&c, 1) == 1) {
+        if (c == '\n') break;
+        if (c != '\r') line += c;
+    }
+    return line;
+}
+
+int HTTPClient::handleHeaderResponse() {
+    responseHeaders.clear();
+    contentLength = -1;
+    chunked = false;
+
+    String status = readLine();
+    if (!status.startsWith("HTTP/1.")) {
+        lastError = status.isEmpty() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_NO_HTTP_SERVER;
+        return lastError;
+    }
+
+    int code = status.substring(9, 12).toInt();
+
+    while (true) {
+        String line = readLine();
+        if (line.isEmpty()) break;
+
+        int colon = line.indexOf(':');
+        if (colon < 0) continue;
+        String name = line.substring(0, colon);
+        String value = line.substring(colon + 1);
+        value.trim();
+
+        if (name.equalsIgnoreCase("Content-Length")) {
+            contentLength = (int)value.toInt();
+        } else if (name.equalsIgnoreCase("Transfer-Encoding")) {
+            chunked = value.equalsIgnoreCase("chunked");
+        }
+
+        for (auto& key : collectKeys) {
+            if (key.equalsIgnoreCase(name)) {
+                responseHeaders.push_back({name, value});
+            }
+        }
+    }
+
+    return code;
+}
+
+int HTTPClient::getSize() {
+    return chunked ? -1 : contentLength;
+}
+
+WiFiClient& HTTPClient::getStream() {
+    return client;
+}
+
+WiFiClient* HTTPClient::getStreamPtr() {
+    return &client;
+}
+
+String HTTPClient::getString() {
+    String body;
+    char buf[512];
+
+    if (chunked) {
+        while (true) {
+            String sizeLine = readLine();
+            long chunkSize = strtol(sizeLine.c_str(), nullptr, 16);
+            if (chunkSize <= 0) break;
+            while (chunkSize > 0) {
+                size_t want = chunkSize < (long)sizeof(buf) ? (size_t)chunkSize : sizeof(buf);
+                size_t n = client.readBytes(buf, want);
+                if (n == 0) return body;
+                body.concat(buf, (unsigned int)n);
+                chunkSize -= (long)n;
+            }
+            readLine(); // CRLF after each chunk
+        }
+        return body;
+    }
+
+    int remaining = contentLength;
+    while (remaining != 0) {
+        size_t want = (remaining < 0 || remaining > (int)sizeof(buf)) ? sizeof(buf) : (size_t)remaining;
+        size_t n = client.readBytes(buf, want);
+        if (n == 0) break;
+        body.concat(buf, (unsigned int)n);
+        if (remaining > 0) remaining -= (int)n;
+    }
+    return body;
+}
+
+bool HTTPClient::connected() {
+    return client.connected();
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+    case HTTPC_ERROR_CONNECTION_REFUSED: return "connection refused";
+    case HTTPC_ERROR_SEND_HEADER_FAILED: return "send header failed";
+    case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return "send payload failed";
+    case HTTPC_ERROR_NOT_CONNECTED: return "not connected";
+    case HTTPC_ERROR_CONNECTION_LOST: return "connection lost";
+    case HTTPC_ERROR_NO_STREAM: return "no stream";
+    case HTTPC_ERROR_NO_HTTP_SERVER: return "no HTTP server";
+    case HTTPC_ERROR_TOO_LESS_RAM: return "too less ram";
+    case HTTPC_ERROR_ENCODING: return "Transfer-Encoding not supported";
+    case HTTPC_ERROR_STREAM_WRITE: return "Stream write error";
+    case HTTPC_ERROR_READ_TIMEOUT: return "read Timeout";
+    default: return String();
+    }
+}
@@ -0,0 +1,90 @@
+// Host shim: subset of the ESP32 HTTPClient API over plain-HTTP sockets.
+// Like the ESP32 client, getStream() returns the raw connection positioned
+// at the start of the body, so chunked bodies arrive still chunk-encoded.
+#ifndef APTOS_HOST_HTTPCLIENT_H
+#define APTOS_HOST_HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <vector>
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT (5000)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_ACCEPTED = 202,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500
+} t_http_codes;
+
+class HTTPClient {
+private:
+    struct Header {
+        String name;
+        String value;
+    };
+
+    WiFiClient client;
+    String host;
+    uint16_t port;
+    String path;
+    bool urlValid;
+    uint16_t timeoutMs;
+    int32_t connectTimeoutMs;
+    bool reuse;
+    bool http10;
+    std::vector<Header> requestHeaders;
+    std::vector<String> collectKeys;
+    std::vector<Header> responseHeaders;
+    int contentLength;
+    bool chunked;
+    int lastError;
+
+    int handleHeaderResponse();
+    int sendHeader(const char* type, size_t size, bool hasBody);
+    String readLine();
+
+public:
+    HTTPClient();
+    ~HTTPClient();
+
+    bool begin(const String& url);
+    void end();
+    void setReuse(bool reuse);
+    void setTimeout(uint16_t timeout);
+    void setConnectTimeout(int32_t timeout);
+    void useHTTP10(bool usehttp10 = true);
+    void addHeader(const String& name, const String& value);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    bool hasHeader(const char* name);
+
+    int GET();
+    int POST(uint8_t* payload, size_t size);
+    int POST(const String& payload);
+    int sendRequest(const char* type, uint8_t* payload = nullptr, size_t size = 0);
+    int sendRequest(const char* type, Stream* stream, size_t size = 0);
+
+    int getSize();
+    WiFiClient& getStream();
+    WiFiClient* getStreamPtr();
+    String getString();
+    bool connected();
+
+    static String errorToString(int error);
+};
+
+#endif
@@ -0,0 +1,28 @@
+// Host shim: the host network is always "connected".
+#ifndef APTOS_HOST_WIFI_H
+#define APTOS_HOST_WIFI_H
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+class HostWiFi {
+public:
+    wl_status_t begin(const char*, const char* = nullptr) { return WL_CONNECTED; }
+    wl_status_t status() { return WL_CONNECTED; }
+    bool isConnected() { return true; }
+    bool disconnect(bool = false) { return true; }
+    int RSSI() { return 0; }
+    String localIP() { return "127.0.0.1"; }
+};
+
+extern HostWiFi WiFi;
+
+#endif
@@ -0,0 +1,168 @@
+#include "WiFiClient.h"
+#include "WiFi.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+HostWiFi WiFi;
+
+WiFiClient::WiFiClient() : fd(-1), rxStart(0), rxEnd(0), peerClosed(false) {
+}
+
+WiFiClient::~WiFiClient() {
+    stop();
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    return connect(host, port, 5000);
+}
+
+// connect() that gives up after timeoutMs, as the ESP32 client does
+static bool connectWithin(int s, const struct sockaddr* addr, socklen_t addrLen, int32_t timeoutMs) {
+    int flags = fcntl(s, F_GETFL, 0);
+    fcntl(s, F_SETFL, flags | O_NONBLOCK);
+    bool ok = ::connect(s, addr, addrLen) == 0;
+    if (!ok && errno == EINPROGRESS) {
+        struct pollfd pfd;
+        pfd.fd = s;
+        pfd.events = POLLOUT;
+        int error = 0;
+        socklen_t errorLen = sizeof(error);
+        ok = poll(&pfd, 1, timeoutMs < 0 ? -1 : (int)timeoutMs) > 0 &&
+             getsockopt(s, SOL_SOCKET, SO_ERROR, &error, &errorLen) == 0 && error == 0;
+    }
+    fcntl(s, F_SETFL, flags);
+    return ok;
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+    stop();
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    char portStr[8];
+    snprintf(portStr, sizeof(portStr), "%u", port);
+
+    struct addrinfo* result = nullptr;
+    if (getaddrinfo(host, portStr, &hints, &result) != 0) {
+        return 0;
+    }
+
+    for (struct addrinfo* ai = result; ai; ai = ai->ai_next) {
+        int s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s < 0) continue;
+        if (connectWithin(s, ai->ai_addr, ai->ai_addrlen, timeoutMs)) {
+            int one = 1;
+            setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            fd = s;
+            break;
+        }
+        close(s);
+    }
+
+    freeaddrinfo(result);
+    rxStart = rxEnd = 0;
+    peerClosed = false;
+    return fd >= 0 ? 1 : 0;
+}
+
+uint8_t WiFiClient::connected() {
+    if (fd < 0) return 0;
+    if (rxStart < rxEnd) return 1;
+    fill(0);
+    return (rxStart < rxEnd || !peerClosed) ? 1 : 0;
+}
+
+void WiFiClient::stop() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    rxStart = rxEnd = 0;
+    peerClosed = false;
+}
+
+bool WiFiClient::fill(unsigned long waitMs) {
+    if (rxStart < rxEnd) return true;
+    if (fd < 0 || peerClosed) return false;
+
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, (int)waitMs) <= 0) {
+        return false;
+    }
+
+    ssize_t n = recv(fd, rxBuffer, sizeof(rxBuffer), 0);
+    if (n <= 0) {
+        peerClosed = true;
+        return false;
+    }
+
+    rxStart = 0;
+    rxEnd = (size_t)n;
+    return true;
+}
+
+size_t WiFiClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (fd < 0) return 0;
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(fd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            break;
+        }
+        sent += (size_t)n;
+    }
+    return sent;
+}
+
+int WiFiClient::available() {
+    fill(0);
+    return (int)(rxEnd - rxStart);
+}
+
+int WiFiClient::read() {
+    if (!fill(0)) return -1;
+    return rxBuffer[rxStart++];
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (!fill(0)) return -1;
+    size_t n = rxEnd - rxStart;
+    if (n > size) n = size;
+    memcpy(buffer, rxBuffer + rxStart, n);
+    rxStart += n;
+    return (int)n;
+}
+
+int WiFiClient::peek() {
+    if (!fill(0)) return -1;
+    return rxBuffer[rxStart];
+}
+
+size_t WiFiClient::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        if (!fill(_timeout)) break;
+        size_t n = rxEnd - rxStart;
+        if (n > length - count) n = length - count;
+        memcpy(buffer + count, rxBuffer + rxStart, n);
+        rxStart += n;
+        count += n;
+    }
+    return count;
+}
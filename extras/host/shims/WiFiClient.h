@@ -0,0 +1,41 @@
+// Host shim: blocking TCP client over POSIX sockets.
+#ifndef APTOS_HOST_WIFICLIENT_H
+#define APTOS_HOST_WIFICLIENT_H
+
+#include <Arduino.h>
+
+class WiFiClient : public Stream {
+private:
+    int fd;
+    uint8_t rxBuffer[1024];
+    size_t rxStart;
+    size_t rxEnd;
+    bool peerClosed;
+
+    bool fill(unsigned long waitMs);
+
+public:
+    WiFiClient();
+    ~WiFiClient();
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+
+    int connect(const char* host, uint16_t port);
+    int connect(const char* host, uint16_t port, int32_t timeoutMs);
+    uint8_t connected();
+    void stop();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size);
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    using Print::write;
+    using Stream::readBytes;
+
+    operator bool() { return connected(); }
+};
+
+#endif
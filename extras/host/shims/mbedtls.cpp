@@ -0,0 +1,154 @@
+// Host shim: mbedTLS digest, Base64 and RNG APIs backed by OpenSSL.
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/base64.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include <string.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224) {
+    ctx->is224 = is224;
+    return (is224 ? SHA224_Init(&ctx->ctx) : SHA256_Init(&ctx->ctx)) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t ilen) {
+    return SHA256_Update(&ctx->ctx, input, ilen) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char* output) {
+    return SHA256_Final(output, &ctx->ctx) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha256(const unsigned char* input, size_t ilen, unsigned char* output, int is224) {
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts(&ctx, is224);
+    mbedtls_sha256_update(&ctx, input, ilen);
+    int ret = mbedtls_sha256_finish(&ctx, output);
+    mbedtls_sha256_free(&ctx);
+    return ret;
+}
+
+void mbedtls_sha512_init(mbedtls_sha512_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha512_free(mbedtls_sha512_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha512_clone(mbedtls_sha512_context* dst, const mbedtls_sha512_context* src) {
+    *dst = *src;
+}
+
+int mbedtls_sha512_starts(mbedtls_sha512_context* ctx, int is384) {
+    ctx->is384 = is384;
+    return (is384 ? SHA384_Init(&ctx->ctx) : SHA512_Init(&ctx->ctx)) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha512_update(mbedtls_sha512_context* ctx, const unsigned char* input, size_t ilen) {
+    return SHA512_Update(&ctx->ctx, input, ilen) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha512_finish(mbedtls_sha512_context* ctx, unsigned char* output) {
+    return SHA512_Final(output, &ctx->ctx) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha512(const unsigned char* input, size_t ilen, unsigned char* output, int is384) {
+    mbedtls_sha512_context ctx;
+    mbedtls_sha512_init(&ctx);
+    mbedtls_sha512_starts(&ctx, is384);
+    mbedtls_sha512_update(&ctx, input, ilen);
+    int ret = mbedtls_sha512_finish(&ctx, output);
+    mbedtls_sha512_free(&ctx);
+    return ret;
+}
+
+int mbedtls_base64_encode(unsigned char* dst, size_t dlen, size_t* olen,
+                          const unsigned char* src, size_t slen) {
+    size_t needed = 4 * ((slen + 2) / 3) + 1;
+    if (dst == nullptr || dlen < needed) {
+        *olen = needed;
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+    *olen = (size_t)EVP_EncodeBlock(dst, src, (int)slen);
+    return 0;
+}
+
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen,
+                          const unsigned char* src, size_t slen) {
+    if (slen % 4 != 0) {
+        return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    }
+
+    size_t padding = 0;
+    if (slen > 0 && src[slen - 1] == '=') padding++;
+    if (slen > 1 && src[slen - 2] == '=') padding++;
+
+    size_t needed = slen / 4 * 3 - padding;
+    if (dst == nullptr || dlen < needed) {
+        *olen = needed;
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+
+    // EVP_DecodeBlock writes whole 3-byte groups, padding included
+    unsigned char* scratch = new unsigned char[slen / 4 * 3 + 1];
+    int decoded = EVP_DecodeBlock(scratch, src, (int)slen);
+    if (decoded < 0) {
+        delete[] scratch;
+        return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    }
+
+    memcpy(dst, scratch, needed);
+    delete[] scratch;
+    *olen = needed;
+    return 0;
+}
+
+void mbedtls_entropy_init(mbedtls_entropy_context* ctx) {
+    ctx->initialized = 1;
+}
+
+void mbedtls_entropy_free(mbedtls_entropy_context* ctx) {
+    ctx->initialized = 0;
+}
+
+int mbedtls_entropy_func(void* data, unsigned char* output, size_t len) {
+    (void)data;
+    return RAND_bytes(output, (int)len) == 1 ? 0 : -1;
+}
+
+void mbedtls_ctr_drbg_init(mbedtls_ctr_drbg_context* ctx) {
+    ctx->seeded = 0;
+}
+
+void mbedtls_ctr_drbg_free(mbedtls_ctr_drbg_context* ctx) {
+    ctx->seeded = 0;
+}
+
+int mbedtls_ctr_drbg_seed(mbedtls_ctr_drbg_context* ctx,
+                          int (*f_entropy)(void*, unsigned char*, size_t), void* p_entropy,
+                          const unsigned char* custom, size_t len) {
+    (void)f_entropy;
+    (void)p_entropy;
+    if (custom && len) {
+        RAND_add(custom, (int)len, 0);
+    }
+    ctx->seeded = 1;
+    return 0;
+}
+
+int mbedtls_ctr_drbg_random(void* p_rng, unsigned char* output, size_t output_len) {
+    (void)p_rng;
+    return RAND_bytes(output, (int)output_len) == 1 ? 0 : -1;
+}
@@ -0,0 +1,4 @@
+// Host shim: included by the SDK headers, no symbols are used.
+#ifndef APTOS_HOST_MBEDTLS_ECDSA_H
+#define APTOS_HOST_MBEDTLS_ECDSA_H
+#endif
@@ -0,0 +1,15 @@
+// Host shim: mbedTLS entropy source backed by the OS random generator.
+#ifndef APTOS_HOST_MBEDTLS_ENTROPY_H
+#define APTOS_HOST_MBEDTLS_ENTROPY_H
+
+#include <stddef.h>
+
+typedef struct {
+    int initialized;
+} mbedtls_entropy_context;
+
+void mbedtls_entropy_init(mbedtls_entropy_context* ctx);
+void mbedtls_entropy_free(mbedtls_entropy_context* ctx);
+int mbedtls_entropy_func(void* data, unsigned char* output, size_t len);
+
+#endif
@@ -0,0 +1,23 @@
+// Host shim: mbedTLS SHA-256 API backed by OpenSSL.
+#ifndef APTOS_HOST_MBEDTLS_SHA256_H
+#define APTOS_HOST_MBEDTLS_SHA256_H
+
+#include <stddef.h>
+#ifndef OPENSSL_SUPPRESS_DEPRECATED
+#define OPENSSL_SUPPRESS_DEPRECATED
+#endif
+#include <openssl/sha.h>
+
+typedef struct {
+    SHA256_CTX ctx;
+    int is224;
+} mbedtls_sha256_context;
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx);
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx);
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224);
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t ilen);
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char* output);
+int mbedtls_sha256(const unsigned char* input, size_t ilen, unsigned char* output, int is224);
+
+#endif
@@ -1,6 +1,16 @@
 #include "AptosAccount.h"
 #include "AptosUtils.h"
 
+// TransactionAuthenticator::Ed25519
+#define AUTHENTICATOR_VARIANT_ED25519 0
+
+// Authentication key scheme byte appended to the public key
+#define SINGLE_KEY_SCHEME_ED25519 0x00
+
+// Magic bytes marking a stored key in EEPROM
+#define EEPROM_MAGIC_0 'A'
+#define EEPROM_MAGIC_1 'P'
+
 AptosAccount::AptosAccount() : isInitialized(false) {
     memset(privateKey, 0, PRIVATE_KEY_SIZE);
     memset(publicKey, 0, PUBLIC_KEY_SIZE);
@@ -55,37 +65,26 @@ bool AptosAccount::fromPrivateKey(const String& privateKeyHex) {
 }
 
 bool AptosAccount::generateKeyPair() {
-    // For Ed25519, the public key is derived from private key
-    // This is a simplified implementation - in production, use proper Ed25519 library
-    
-    // Calculate SHA256 of private key as public key (simplified)
-    mbedtls_sha256_context sha256_ctx;
-    mbedtls_sha256_init(&sha256_ctx);
-    mbedtls_sha256_starts(&sha256_ctx, 0); // 0 = SHA256
-    mbedtls_sha256_update(&sha256_ctx, privateKey, PRIVATE_KEY_SIZE);
-    mbedtls_sha256_finish(&sha256_ctx, publicKey);
-    mbedtls_sha256_free(&sha256_ctx);
+    // Ed25519: expand the seed once and keep the scalar/prefix for signing
+    if (!AptosEd25519::expandSecret(privateKey, secretScalar, noncePrefix)) {
+        return false;
+    }
+    AptosEd25519::publicKeyFromScalar(secretScalar, publicKey);
     
     isInitialized = deriveAddress();
     return isInitialized;
 }
 
 bool AptosAccount::deriveAddress() {
-    // Address = SHA3-256(public_key + 0x00)[0:32]
-    // Simplified: use SHA256 instead of SHA3-256
-    uint8_t input[PUBLIC_KEY_SIZE + 1];
-    memcpy(input, publicKey, PUBLIC_KEY_SIZE);
-    input[PUBLIC_KEY_SIZE] = 0x00; // Single signature scheme
-    
-    uint8_t hash[32];
-    mbedtls_sha256_context sha256_ctx;
-    mbedtls_sha256_init(&sha256_ctx);
-    mbedtls_sha256_starts(&sha256_ctx, 0);
-    mbedtls_sha256_update(&sha256_ctx, input, PUBLIC_KEY_SIZE + 1);
-    mbedtls_sha256_finish(&sha256_ctx, hash);
-    mbedtls_sha256_free(&sha256_ctx);
-    
-    address = "0x" + AptosUtils::bytesToHex(hash, ADDRESS_SIZE);
+    // Address = SHA3-256(public_key || 0x00), fed to the hasher in two parts
+    uint8_t hash[SHA3_256_DIGEST_SIZE];
+    AptosSHA3 hasher;
+    hasher.update(publicKey, PUBLIC_KEY_SIZE);
+    hasher.update((uint8_t)SINGLE_KEY_SCHEME_ED25519);
+    hasher.finish(hash);
+    
+    accountAddress = AccountAddress(hash);
+    address = accountAddress.toString();
     return true;
 }
 
@@ -103,28 +102,24 @@ String AptosAccount::getAddress() const {
     return address;
 }
 
+const AccountAddress& AptosAccount::getAccountAddress() const {
+    return accountAddress;
+}
+
 bool AptosAccount::isValid() const {
     return isInitialized;
 }
 
 bool AptosAccount::signMessage(const uint8_t* message, size_t messageLen, uint8_t* signature) {
+    return signMessage(nullptr, 0, message, messageLen, signature);
+}
+
+bool AptosAccount::signMessage(const uint8_t* prefix, size_t prefixLen,
+                               const uint8_t* message, size_t messageLen, uint8_t* signature) {
     if (!isInitialized) return false;
     
-    // Create message hash
-    uint8_t messageHash[32];
-    mbedtls_sha256_context sha256_ctx;
-    mbedtls_sha256_init(&sha256_ctx);
-    mbedtls_sha256_starts(&sha256_ctx, 0);
-    mbedtls_sha256_update(&sha256_ctx, message, messageLen);
-    mbedtls_sha256_finish(&sha256_ctx, messageHash);
-    mbedtls_sha256_free(&sha256_ctx);
-    
-    // Simplified signing: XOR with private key (NOT secure - use proper Ed25519)
-    for (int i = 0; i < SIGNATURE_SIZE; i++) {
-        signature[i] = messageHash[i % 32] ^ privateKey[i % PRIVATE_KEY_SIZE];
-    }
-    
-    return true;
+    return AptosEd25519::sign(secretScalar, noncePrefix, publicKey,
+                              prefix, prefixLen, message, messageLen, signature);
 }
 
 bool AptosAccount::signTransaction(const JsonDocument& transaction, String& signedTxn) {
@@ -157,14 +152,53 @@ bool AptosAccount::signTransaction(const JsonDocument& transaction, String& sign
     return true;
 }
 
+bool AptosAccount::signTransaction(AptosTransaction& transaction, AptosBCSWriter& signedTxn) {
+    if (!isInitialized) return false;
+    
+    signedTxn.clear();
+    if (!transaction.serializeBCS(signedTxn)) {
+        return false;
+    }
+    
+    // Signing message is prefix || RawTransaction; the prefix is never copied
+    uint8_t signature[SIGNATURE_SIZE];
+    if (!signMessage(AptosTransaction::RAW_TRANSACTION_PREFIX, sizeof(AptosTransaction::RAW_TRANSACTION_PREFIX),
+                     signedTxn.data(), signedTxn.size(), signature)) {
+        return false;
+    }
+    
+    signedTxn.writeVariantIndex(AUTHENTICATOR_VARIANT_ED25519);
+    signedTxn.writeBytes(publicKey, PUBLIC_KEY_SIZE);
+    signedTxn.writeBytes(signature, SIGNATURE_SIZE);
+    return signedTxn.ok();
+}
+
+bool AptosAccount::signTransaction(const AptosTransactionTemplate& transaction, AptosBCSWriter& signedTxn) {
+    if (!isInitialized || !transaction.isValid()) return false;
+    
+    // The template is already a RawTransaction
+    uint8_t signature[SIGNATURE_SIZE];
+    if (!signMessage(AptosTransaction::RAW_TRANSACTION_PREFIX, sizeof(AptosTransaction::RAW_TRANSACTION_PREFIX),
+                     transaction.data(), transaction.size(), signature)) {
+        return false;
+    }
+    
+    signedTxn.clear();
+    signedTxn.writeFixedBytes(transaction.data(), transaction.size());
+    signedTxn.writeVariantIndex(AUTHENTICATOR_VARIANT_ED25519);
+    signedTxn.writeBytes(publicKey, PUBLIC_KEY_SIZE);
+    signedTxn.writeBytes(signature, SIGNATURE_SIZE);
+    return signedTxn.ok();
+}
+
 bool AptosAccount::saveToEEPROM(int offset) {
     if (!isInitialized) return false;
     
     EEPROM.begin(512);
     
     // Write magic bytes
-    EEPROM.write(offset, 0xAP);
-    EEPROM.write(offset + 1, 0xTO);
+    EEPROM.write(offset, EEPROM_MAGIC_0);
+    EEPROM.write(offset + 1, EEPROM_MAGIC_1);
     
     // Write private key
     for (int i = 0; i < PRIVATE_KEY_SIZE; i++) {
@@ -179,7 +213,7 @@ bool AptosAccount::loadFromEEPROM(int offset) {
     EEPROM.begin(512);
     
     // Check magic bytes
-    if (EEPROM.read(offset) != 0xAP || EEPROM.read(offset + 1) != 0xTO) {
+    if (EEPROM.read(offset) != EEPROM_MAGIC_0 || EEPROM.read(offset + 1) != EEPROM_MAGIC_1) {
         return false;
     }
     
@@ -195,20 +229,15 @@ bool AptosAccount::verifySignature(const uint8_t* message, size_t messageLen,
                                   const uint8_t* signature) const {
     if (!isInitialized) return false;
     
-    // Create test signature
-    uint8_t testSignature[SIGNATURE_SIZE];
-    AptosAccount* self = const_cast<AptosAccount*>(this);
-    if (!self->signMessage(message, messageLen, testSignature)) {
-        return false;
-    }
-    
-    // Compare signatures
-    return memcmp(signature, testSignature, SIGNATURE_SIZE) == 0;
+    return AptosEd25519::verify(publicKey, nullptr, 0, message, messageLen, signature);
 }
 
 void AptosAccount::clear() {
     memset(privateKey, 0, PRIVATE_KEY_SIZE);
     memset(publicKey, 0, PUBLIC_KEY_SIZE);
+    memset(secretScalar, 0, ED25519_SCALAR_SIZE);
+    memset(noncePrefix, 0, sizeof(noncePrefix));
+    accountAddress = AccountAddress();
     address = "";
     isInitialized = false;
 }
@@ -8,6 +8,9 @@
 #include <mbedtls/ecdsa.h>
 #include <mbedtls/sha256.h>
 #include <EEPROM.h>
+#include "AptosTransaction.h"
+#include "AptosTransactionTemplate.h"
+#include "AptosEd25519.h"
 
 #define PRIVATE_KEY_SIZE 32
 #define PUBLIC_KEY_SIZE 32
@@ -18,6 +21,10 @@ class AptosAccount {
 private:
     uint8_t privateKey[PRIVATE_KEY_SIZE];
     uint8_t publicKey[PUBLIC_KEY_SIZE];
+    // Expanded Ed25519 secret, derived once per key so signing skips SHA-512(seed)
+    uint8_t secretScalar[ED25519_SCALAR_SIZE];
+    uint8_t noncePrefix[32];
+    AccountAddress accountAddress;
     String address;
     bool isInitialized;
     
@@ -46,12 +53,19 @@ public:
     String getPrivateKeyHex() const;
     String getPublicKeyHex() const;
     String getAddress() const;
+    const AccountAddress& getAccountAddress() const;
     bool isValid() const;
     
     // Signing
     bool signMessage(const uint8_t* message, size_t messageLen, uint8_t* signature);
+    bool signMessage(const uint8_t* prefix, size_t prefixLen,
+                     const uint8_t* message, size_t messageLen, uint8_t* signature);
     bool signTransaction(const JsonDocument& transaction, String& signedTxn);
     
+    // BCS SignedTransaction: RawTransaction followed by an Ed25519 authenticator
+    bool signTransaction(AptosTransaction& transaction, AptosBCSWriter& signedTxn);
+    bool signTransaction(const AptosTransactionTemplate& transaction, AptosBCSWriter& signedTxn);
+    
     // Storage (EEPROM)
     bool saveToEEPROM(int offset = 0);
     bool loadFromEEPROM(int offset = 0);
@@ -64,3 +78,5 @@ public:
     void clear();
     void print() const;
 };
+
+#endif
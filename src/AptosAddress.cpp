@@ -0,0 +1,124 @@
+#include "AptosAddress.h"
+#include "AptosUtils.h"
+
+static const uint8_t oneBytes[ACCOUNT_ADDRESS_LENGTH] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+static const uint8_t threeBytes[ACCOUNT_ADDRESS_LENGTH] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3};
+
+const AccountAddress AccountAddress::ZERO;
+const AccountAddress AccountAddress::ONE(oneBytes);
+const AccountAddress AccountAddress::THREE(threeBytes);
+
+AccountAddress::AccountAddress() {
+    memset(bytes, 0, ACCOUNT_ADDRESS_LENGTH);
+}
+
+AccountAddress::AccountAddress(const uint8_t* bytes) {
+    memcpy(this->bytes, bytes, ACCOUNT_ADDRESS_LENGTH);
+}
+
+bool AccountAddress::parse(const char* hex, size_t length) {
+    if (length >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        hex += 2;
+        length -= 2;
+    }
+    if (length == 0 || length > ACCOUNT_ADDRESS_LENGTH * 2) {
+        return false;
+    }
+
+    // Short addresses ("0x1") are left-padded with zeros; an odd digit count
+    // leaves the first one on its own in the low nibble
+    uint8_t parsed[ACCOUNT_ADDRESS_LENGTH];
+    size_t leading = ACCOUNT_ADDRESS_LENGTH - (length + 1) / 2;
+    memset(parsed, 0, leading);
+    if (length & 1) {
+        uint8_t nibble = AptosUtils::hexValue(hex[0]);
+        if (nibble == 0xFF) {
+            return false;
+        }
+        parsed[leading++] = nibble;
+        hex++;
+        length--;
+    }
+    // decodeHex would take a second "0x"; the byte count catches it
+    size_t written;
+    if (!AptosUtils::decodeHex(hex, length, parsed + leading, ACCOUNT_ADDRESS_LENGTH - leading, &written) ||
+        leading + written != ACCOUNT_ADDRESS_LENGTH) {
+        return false;
+    }
+
+    memcpy(bytes, parsed, ACCOUNT_ADDRESS_LENGTH);
+    return true;
+}
+
+bool AccountAddress::parse(const char* hex) {
+    return parse(hex, strlen(hex));
+}
+
+bool AccountAddress::parse(const String& hex) {
+    return parse(hex.c_str(), hex.length());
+}
+
+bool AccountAddress::isValid(const String& hex) {
+    AccountAddress address;
+    return address.parse(hex);
+}
+
+void AccountAddress::format(char* out) const {
+    out[0] = '0';
+    out[1] = 'x';
+    AptosUtils::encodeHex(bytes, ACCOUNT_ADDRESS_LENGTH, out + 2);
+}
+
+String AccountAddress::toString() const {
+    char hex[ACCOUNT_ADDRESS_HEX_SIZE];
+    format(hex);
+    return String(hex);
+}
+
+String AccountAddress::toShortString() const {
+    if (!isSpecial()) {
+        return toString();
+    }
+    char hex[4] = {'0', 'x', "0123456789abcdef"[bytes[ACCOUNT_ADDRESS_LENGTH - 1]], 0};
+    return String(hex);
+}
+
+const uint8_t* AccountAddress::data() const {
+    return bytes;
+}
+
+bool AccountAddress::isZero() const {
+    return *this == ZERO;
+}
+
+bool AccountAddress::isSpecial() const {
+    for (size_t i = 0; i < ACCOUNT_ADDRESS_LENGTH - 1; i++) {
+        if (bytes[i] != 0) {
+            return false;
+        }
+    }
+    return bytes[ACCOUNT_ADDRESS_LENGTH - 1] < 16;
+}
+
+bool AccountAddress::operator==(const AccountAddress& other) const {
+    return memcmp(bytes, other.bytes, ACCOUNT_ADDRESS_LENGTH) == 0;
+}
+
+bool AccountAddress::operator!=(const AccountAddress& other) const {
+    return !(*this == other);
+}
+
+bool AccountAddress::operator<(const AccountAddress& other) const {
+    return memcmp(bytes, other.bytes, ACCOUNT_ADDRESS_LENGTH) < 0;
+}
+
+size_t AccountAddress::hash() const {
+    // The low-order bytes, so that the framework addresses differ too
+    size_t value;
+    memcpy(&value, bytes + ACCOUNT_ADDRESS_LENGTH - sizeof(value), sizeof(value));
+    return value;
+}
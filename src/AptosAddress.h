@@ -0,0 +1,66 @@
+#ifndef APTOS_ADDRESS_H
+#define APTOS_ADDRESS_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define ACCOUNT_ADDRESS_LENGTH 32
+
+// "0x" + 64 hex digits + NUL
+#define ACCOUNT_ADDRESS_HEX_SIZE 67
+
+// An account address as its 32 raw bytes.
+//
+// Parsed once from hex ("0x1", "0X00..AB", with or without the prefix, up
+// to 64 digits, short forms left-padded with zeros) and then passed around
+// by value: comparing, hashing and BCS-encoding it never touches the heap.
+// Formatting gives the long form the node uses in URLs
+// ("0x" + 64 lowercase digits). Usable as a key in std::map and
+// std::unordered_map.
+class AccountAddress {
+private:
+    uint8_t bytes[ACCOUNT_ADDRESS_LENGTH];
+
+public:
+    // 0x0
+    AccountAddress();
+    explicit AccountAddress(const uint8_t* bytes);
+
+    // False (and *this left unchanged) if hex is not a valid address
+    bool parse(const char* hex, size_t length);
+    bool parse(const char* hex);
+    bool parse(const String& hex);
+    static bool isValid(const String& hex);
+
+    // Long form; out holds ACCOUNT_ADDRESS_HEX_SIZE characters
+    void format(char* out) const;
+    String toString() const;
+    // Special addresses (0x0 to 0xf) the way Move writes them: "0x1"
+    String toShortString() const;
+
+    const uint8_t* data() const;
+    bool isZero() const;
+    bool isSpecial() const;
+
+    bool operator==(const AccountAddress& other) const;
+    bool operator!=(const AccountAddress& other) const;
+    bool operator<(const AccountAddress& other) const;
+    // Addresses are hashes already, so a slice of them is a good hash
+    size_t hash() const;
+
+    // Framework addresses
+    static const AccountAddress ZERO;
+    static const AccountAddress ONE;
+    static const AccountAddress THREE;
+};
+
+namespace std {
+template <>
+struct hash<AccountAddress> {
+    size_t operator()(const AccountAddress& address) const {
+        return address.hash();
+    }
+};
+}
+
+#endif
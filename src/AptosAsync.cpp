@@ -0,0 +1,334 @@
+#include "AptosAsync.h"
+#ifdef ESP32
+#include <esp_pthread.h>
+#endif
+
+static void copyArray(const JsonArray& source, JsonDocument& target) {
+    JsonArray array = target.to<JsonArray>();
+    for (JsonVariant value : source) {
+        array.add(value);
+    }
+}
+
+AptosAsync::AptosAsync(AptosSDK& sdk) : sdk(sdk), nextId(1), started(false), stopping(false) {
+    for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+        slots[i].id = 0;
+        slots[i].state = APTOS_ASYNC_UNKNOWN;
+        slots[i].callback = nullptr;
+        slots[i].context = nullptr;
+        slots[i].ok = false;
+    }
+}
+
+AptosAsync::~AptosAsync() {
+    end();
+}
+
+bool AptosAsync::begin() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (started) {
+        return true;
+    }
+    stopping = false;
+#ifdef ESP32
+    // HTTPClient (and TLS) need more than the default pthread stack
+    esp_pthread_cfg_t config = esp_pthread_get_default_config();
+    config.stack_size = APTOS_ASYNC_STACK_SIZE;
+    esp_pthread_set_cfg(&config);
+#endif
+    worker = std::thread([this]() { run(); });
+    started = true;
+    return true;
+}
+
+void AptosAsync::end() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!started) {
+            return;
+        }
+        stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+        slots[i].id = 0;
+        slots[i].state = APTOS_ASYNC_UNKNOWN;
+        slots[i].call = nullptr;
+        slots[i].response.clear();
+    }
+    started = false;
+}
+
+AptosAsync::Slot* AptosAsync::find(uint32_t id) {
+    for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+        if (id != 0 && slots[i].id == id) {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+const AptosAsync::Slot* AptosAsync::find(uint32_t id) const {
+    return const_cast<AptosAsync*>(this)->find(id);
+}
+
+AptosAsync::Slot* AptosAsync::nextQueued() {
+    // Oldest first; ids only grow
+    Slot* next = nullptr;
+    for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+        if (slots[i].state == APTOS_ASYNC_QUEUED && (next == nullptr || slots[i].id < next->id)) {
+            next = &slots[i];
+        }
+    }
+    return next;
+}
+
+void AptosAsync::run() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        changed.wait(guard, [this]() { return stopping || nextQueued() != nullptr; });
+        if (stopping) {
+            return;
+        }
+
+        Slot* slot = nextQueued();
+        slot->state = APTOS_ASYNC_RUNNING;
+        AptosAsyncCall call = std::move(slot->call);
+        slot->call = nullptr;
+        guard.unlock();
+
+        // The blocking call runs without the lock so callers can poll
+        JsonDocument response;
+        bool ok = call(sdk, response);
+
+        guard.lock();
+        slot->response = std::move(response);
+        slot->ok = ok;
+        slot->state = APTOS_ASYNC_DONE;
+        changed.notify_all();
+    }
+}
+
+uint32_t AptosAsync::submit(AptosAsyncCall call, AptosAsyncCallback callback, void* context) {
+    if (!begin()) {
+        return 0;
+    }
+
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        Slot* slot = nullptr;
+        for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+            if (slots[i].state == APTOS_ASYNC_UNKNOWN) {
+                slot = &slots[i];
+                break;
+            }
+        }
+        if (slot == nullptr) {
+            return 0;
+        }
+
+        id = nextId++;
+        if (nextId == 0) {
+            nextId = 1;
+        }
+        slot->id = id;
+        slot->state = APTOS_ASYNC_QUEUED;
+        slot->call = std::move(call);
+        slot->callback = callback;
+        slot->context = context;
+        slot->ok = false;
+        slot->response.clear();
+    }
+    changed.notify_all();
+    return id;
+}
+
+uint32_t AptosAsync::request(const String& endpoint, const String& method, const String& payload,
+                             AptosAsyncCallback callback, void* context) {
+    return submit([endpoint, method, payload](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.makeHttpRequest(endpoint, response, method, payload);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::getLedgerInfo(AptosAsyncCallback callback, void* context) {
+    return submit([](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.getLedgerInfo(response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::getAccount(const String& address, AptosAsyncCallback callback, void* context) {
+    return submit([address](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.getAccount(address, response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::getAccountResource(const String& address, const String& resourceType,
+                                        AptosAsyncCallback callback, void* context) {
+    return submit([address, resourceType](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.getAccountResource(address, resourceType, response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::getTransactionByHash(const String& txnHash, AptosAsyncCallback callback, void* context) {
+    return submit([txnHash](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.getTransactionByHash(txnHash, response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::viewFunction(const String& moduleAddress, const String& moduleName,
+                                  const String& functionName, const JsonArray& typeArgs,
+                                  const JsonArray& args, AptosAsyncCallback callback, void* context) {
+    // The caller's arrays may be gone by the time the worker gets to it
+    JsonDocument typeArgsCopy;
+    JsonDocument argsCopy;
+    copyArray(typeArgs, typeArgsCopy);
+    copyArray(args, argsCopy);
+    return submit([moduleAddress, moduleName, functionName, typeArgsCopy, argsCopy]
+                  (AptosSDK& sdk, JsonDocument& response) mutable {
+        return sdk.viewFunction(moduleAddress, moduleName, functionName,
+                                typeArgsCopy.as<JsonArray>(), argsCopy.as<JsonArray>(), response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::getTableItem(const String& tableHandle, const JsonDocument& tableItemRequest,
+                                  AptosAsyncCallback callback, void* context) {
+    JsonDocument requestCopy = tableItemRequest;
+    return submit([tableHandle, requestCopy](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.getTableItem(tableHandle, requestCopy, response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::estimateGasPrice(AptosAsyncCallback callback, void* context) {
+    return submit([](AptosSDK& sdk, JsonDocument& response) {
+        uint64_t gasPrice;
+        if (!sdk.estimateGasPrice(gasPrice)) {
+            return false;
+        }
+        response["gas_estimate"] = gasPrice;
+        return true;
+    }, callback, context);
+}
+
+uint32_t AptosAsync::transferCoin(AptosAccount& sender, const String& recipient, uint64_t amount,
+                                  AptosAsyncCallback callback, void* context) {
+    return transferCoin(sender, recipient, amount, "0x1::aptos_coin::AptosCoin", callback, context);
+}
+
+uint32_t AptosAsync::transferCoin(AptosAccount& sender, const String& recipient, uint64_t amount,
+                                  const String& coinType, AptosAsyncCallback callback, void* context) {
+    AptosAccount* account = &sender;
+    return submit([account, recipient, amount, coinType](AptosSDK& sdk, JsonDocument& response) {
+        AccountAddress address;
+        return sdk.parseAddress(recipient, address) &&
+               sdk.submitCoinTransfer(*account, address, amount, coinType, response) &&
+               !AptosUtils::getJsonString(response, "hash", "").isEmpty();
+    }, callback, context);
+}
+
+uint32_t AptosAsync::callFunction(AptosAccount& sender, const String& moduleAddress, const String& moduleName,
+                                  const String& functionName, const JsonArray& typeArgs, const JsonArray& args,
+                                  AptosAsyncCallback callback, void* context) {
+    AptosAccount* account = &sender;
+    JsonDocument typeArgsCopy;
+    JsonDocument argsCopy;
+    copyArray(typeArgs, typeArgsCopy);
+    copyArray(args, argsCopy);
+    return submit([account, moduleAddress, moduleName, functionName, typeArgsCopy, argsCopy]
+                  (AptosSDK& sdk, JsonDocument& response) mutable {
+        return sdk.callFunction(*account, moduleAddress, moduleName, functionName,
+                                typeArgsCopy.as<JsonArray>(), argsCopy.as<JsonArray>(), response);
+    }, callback, context);
+}
+
+uint32_t AptosAsync::waitForTransaction(const String& txnHash, uint32_t timeoutMs,
+                                        AptosAsyncCallback callback, void* context) {
+    return submit([txnHash, timeoutMs](AptosSDK& sdk, JsonDocument& response) {
+        return sdk.waitForTransactionStatus(txnHash, response, timeoutMs) == APTOS_TXN_SUCCESS;
+    }, callback, context);
+}
+
+int AptosAsync::poll() {
+    int delivered = 0;
+    while (true) {
+        // One at a time and outside the lock: a callback may queue more
+        uint32_t id;
+        bool ok;
+        AptosAsyncCallback callback;
+        void* context;
+        JsonDocument response;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            Slot* slot = nullptr;
+            for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+                if (slots[i].state == APTOS_ASYNC_DONE && slots[i].callback != nullptr &&
+                    (slot == nullptr || slots[i].id < slot->id)) {
+                    slot = &slots[i];
+                }
+            }
+            if (slot == nullptr) {
+                return delivered;
+            }
+            id = slot->id;
+            ok = slot->ok;
+            callback = slot->callback;
+            context = slot->context;
+            response = std::move(slot->response);
+            slot->id = 0;
+            slot->state = APTOS_ASYNC_UNKNOWN;
+        }
+        callback(id, ok, response, context);
+        delivered++;
+    }
+}
+
+AptosAsyncState AptosAsync::state(uint32_t id) const {
+    std::lock_guard<std::mutex> guard(lock);
+    const Slot* slot = find(id);
+    return slot != nullptr ? slot->state : APTOS_ASYNC_UNKNOWN;
+}
+
+bool AptosAsync::done(uint32_t id) const {
+    return state(id) == APTOS_ASYNC_DONE;
+}
+
+bool AptosAsync::take(uint32_t id, JsonDocument& response, bool& ok) {
+    std::lock_guard<std::mutex> guard(lock);
+    Slot* slot = find(id);
+    if (slot == nullptr || slot->state != APTOS_ASYNC_DONE) {
+        return false;
+    }
+    response = std::move(slot->response);
+    ok = slot->ok;
+    slot->id = 0;
+    slot->state = APTOS_ASYNC_UNKNOWN;
+    return true;
+}
+
+bool AptosAsync::wait(uint32_t id, JsonDocument& response, bool& ok, uint32_t timeoutMs) {
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        bool finished = changed.wait_for(guard, std::chrono::milliseconds(timeoutMs), [this, id]() {
+            const Slot* slot = find(id);
+            return slot == nullptr || slot->state == APTOS_ASYNC_DONE;
+        });
+        if (!finished) {
+            return false;
+        }
+    }
+    return take(id, response, ok);
+}
+
+size_t AptosAsync::pending() const {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t count = 0;
+    for (size_t i = 0; i < APTOS_ASYNC_MAX_REQUESTS; i++) {
+        if (slots[i].state == APTOS_ASYNC_QUEUED || slots[i].state == APTOS_ASYNC_RUNNING) {
+            count++;
+        }
+    }
+    return count;
+}
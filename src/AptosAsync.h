@@ -0,0 +1,130 @@
+#ifndef APTOS_ASYNC_H
+#define APTOS_ASYNC_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <functional>
+#include <condition_variable>
+#include "AptosSDK.h"
+
+// Requests queued or finished but not yet collected
+#ifndef APTOS_ASYNC_MAX_REQUESTS
+#define APTOS_ASYNC_MAX_REQUESTS 8
+#endif
+
+// Stack of the worker task (ESP32); TLS handshakes need most of it
+#ifndef APTOS_ASYNC_STACK_SIZE
+#define APTOS_ASYNC_STACK_SIZE 8192
+#endif
+
+enum AptosAsyncState {
+    APTOS_ASYNC_QUEUED,
+    APTOS_ASYNC_RUNNING,
+    APTOS_ASYNC_DONE,
+    APTOS_ASYNC_UNKNOWN     // Never queued, or already collected
+};
+
+// One blocking SDK call, run on the worker; fills response and returns its result
+typedef std::function<bool(AptosSDK& sdk, JsonDocument& response)> AptosAsyncCall;
+
+typedef void (*AptosAsyncCallback)(uint32_t id, bool ok, JsonDocument& response, void* context);
+
+// Runs SDK calls on a worker task so loop() never waits for the network.
+//
+// Each call returns a request id straight away (0 if the queue is full).
+// The worker, a std::thread (a FreeRTOS task on ESP32), runs the requests
+// one at a time in order through the ordinary blocking methods, so sync
+// and async calls on the same AptosSDK can be mixed freely.
+//
+// A finished request is either handed to its callback, which runs inside
+// poll() on the caller's task (so callbacks may touch the display, Serial
+// and so on without locking), or kept until take() collects it. Arguments
+// are copied when the request is queued; an AptosAccount passed by
+// reference must outlive the request.
+class AptosAsync {
+private:
+    struct Slot {
+        uint32_t id;
+        AptosAsyncState state;
+        AptosAsyncCall call;
+        AptosAsyncCallback callback;
+        void* context;
+        bool ok;
+        JsonDocument response;
+    };
+
+    AptosSDK& sdk;
+    Slot slots[APTOS_ASYNC_MAX_REQUESTS];
+    uint32_t nextId;
+    bool started;
+    bool stopping;
+    std::thread worker;
+    mutable std::mutex lock;
+    std::condition_variable changed;
+
+    Slot* find(uint32_t id);
+    const Slot* find(uint32_t id) const;
+    Slot* nextQueued();
+    void run();
+
+public:
+    AptosAsync(AptosSDK& sdk);
+    ~AptosAsync();
+
+    // Starts the worker; submit() does so on first use
+    bool begin();
+    // Finishes the running request, drops the queued ones and stops
+    void end();
+
+    // Queues any call, e.g. a lambda around an SDK method
+    uint32_t submit(AptosAsyncCall call, AptosAsyncCallback callback = nullptr, void* context = nullptr);
+
+    // Async variants of the common SDK calls; results land in the response
+    // document exactly as the blocking method would leave them
+    uint32_t request(const String& endpoint, const String& method = "GET", const String& payload = "",
+                     AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    uint32_t getLedgerInfo(AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    uint32_t getAccount(const String& address, AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    uint32_t getAccountResource(const String& address, const String& resourceType,
+                                AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    uint32_t getTransactionByHash(const String& txnHash, AptosAsyncCallback callback = nullptr,
+                                  void* context = nullptr);
+    uint32_t viewFunction(const String& moduleAddress, const String& moduleName, const String& functionName,
+                          const JsonArray& typeArgs, const JsonArray& args,
+                          AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    uint32_t getTableItem(const String& tableHandle, const JsonDocument& tableItemRequest,
+                          AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    // response: { "gas_estimate": n }
+    uint32_t estimateGasPrice(AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    // response: { "hash": "0x..." } from the node's answer. APT unless a
+    // coin type is given.
+    uint32_t transferCoin(AptosAccount& sender, const String& recipient, uint64_t amount,
+                          AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    uint32_t transferCoin(AptosAccount& sender, const String& recipient, uint64_t amount,
+                          const String& coinType, AptosAsyncCallback callback = nullptr,
+                          void* context = nullptr);
+    uint32_t callFunction(AptosAccount& sender, const String& moduleAddress, const String& moduleName,
+                          const String& functionName, const JsonArray& typeArgs, const JsonArray& args,
+                          AptosAsyncCallback callback = nullptr, void* context = nullptr);
+    // ok when committed successfully; response is the final transaction
+    uint32_t waitForTransaction(const String& txnHash, uint32_t timeoutMs = 30000,
+                                AptosAsyncCallback callback = nullptr, void* context = nullptr);
+
+    // Runs the callbacks of finished requests; call it from loop().
+    // Returns the number of callbacks run.
+    int poll();
+
+    AptosAsyncState state(uint32_t id) const;
+    bool done(uint32_t id) const;
+
+    // Collects a finished request (one without a callback); false while it
+    // is still queued or running
+    bool take(uint32_t id, JsonDocument& response, bool& ok);
+
+    // Blocks until the request finishes, then collects it; false on timeout
+    bool wait(uint32_t id, JsonDocument& response, bool& ok, uint32_t timeoutMs = 60000);
+
+    size_t pending() const;
+};
+
+#endif
@@ -0,0 +1,240 @@
+#include "AptosBCS.h"
+#include "AptosUtils.h"
+
+AptosBCSWriter::AptosBCSWriter(size_t initialCapacity)
+    : buffer(nullptr), capacity(0), length(0), ownsBuffer(true), failed(false) {
+    if (initialCapacity > 0) {
+        buffer = (uint8_t*)malloc(initialCapacity);
+        if (buffer) {
+            capacity = initialCapacity;
+        }
+    }
+}
+
+AptosBCSWriter::AptosBCSWriter(uint8_t* externalBuffer, size_t bufferSize)
+    : buffer(externalBuffer), capacity(bufferSize), length(0), ownsBuffer(false), failed(false) {
+}
+
+AptosBCSWriter::AptosBCSWriter(const AptosBCSWriter& other)
+    : buffer(nullptr), capacity(0), length(0), ownsBuffer(true), failed(other.failed) {
+    if (other.length > 0 && reserve(other.length)) {
+        memcpy(buffer, other.buffer, other.length);
+        length = other.length;
+    }
+}
+
+AptosBCSWriter& AptosBCSWriter::operator=(const AptosBCSWriter& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    clear();
+    if (ensureCapacity(other.length) && other.length > 0) {
+        memcpy(buffer, other.buffer, other.length);
+        length = other.length;
+    }
+    failed = failed || other.failed;
+    return *this;
+}
+
+AptosBCSWriter::~AptosBCSWriter() {
+    if (ownsBuffer) {
+        free(buffer);
+    }
+}
+
+bool AptosBCSWriter::ensureCapacity(size_t additional) {
+    if (failed) return false;
+
+    if (length + additional <= capacity) {
+        return true;
+    }
+
+    if (!ownsBuffer) {
+        failed = true; // Caller-supplied buffer is full
+        return false;
+    }
+
+    size_t newCapacity = capacity ? capacity : 16;
+    while (newCapacity < length + additional) {
+        newCapacity *= 2;
+    }
+
+    return reserve(newCapacity);
+}
+
+bool AptosBCSWriter::reserve(size_t totalCapacity) {
+    if (totalCapacity <= capacity) {
+        return !failed;
+    }
+
+    if (!ownsBuffer) {
+        return false;
+    }
+
+    uint8_t* grown = (uint8_t*)realloc(buffer, totalCapacity);
+    if (!grown) {
+        failed = true;
+        return false;
+    }
+
+    buffer = grown;
+    capacity = totalCapacity;
+    return true;
+}
+
+bool AptosBCSWriter::writeU8(uint8_t value) {
+    if (!ensureCapacity(1)) return false;
+    buffer[length++] = value;
+    return true;
+}
+
+bool AptosBCSWriter::writeU16(uint16_t value) {
+    if (!ensureCapacity(2)) return false;
+    buffer[length++] = value & 0xFF;
+    buffer[length++] = (value >> 8) & 0xFF;
+    return true;
+}
+
+bool AptosBCSWriter::writeU32(uint32_t value) {
+    if (!ensureCapacity(4)) return false;
+    for (int i = 0; i < 4; i++) {
+        buffer[length++] = (value >> (i * 8)) & 0xFF;
+    }
+    return true;
+}
+
+bool AptosBCSWriter::writeU64(uint64_t value) {
+    if (!ensureCapacity(8)) return false;
+    for (int i = 0; i < 8; i++) {
+        buffer[length++] = (value >> (i * 8)) & 0xFF;
+    }
+    return true;
+}
+
+bool AptosBCSWriter::writeU128(uint64_t low, uint64_t high) {
+    if (!ensureCapacity(16)) return false;
+    writeU64(low);
+    return writeU64(high);
+}
+
+bool AptosBCSWriter::writeU256(const uint8_t* littleEndian) {
+    return writeFixedBytes(littleEndian, 32);
+}
+
+bool AptosBCSWriter::writeBool(bool value) {
+    return writeU8(value ? 1 : 0);
+}
+
+bool AptosBCSWriter::writeUleb128(uint32_t value) {
+    if (!ensureCapacity(uleb128Size(value))) return false;
+
+    while (value >= 0x80) {
+        buffer[length++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    buffer[length++] = (uint8_t)value;
+    return true;
+}
+
+bool AptosBCSWriter::writeVariantIndex(uint32_t index) {
+    return writeUleb128(index);
+}
+
+bool AptosBCSWriter::writeVectorLength(size_t count) {
+    if (count > 0xFFFFFFFFUL) {
+        failed = true; // BCS sequence lengths are limited to u32
+        return false;
+    }
+    return writeUleb128((uint32_t)count);
+}
+
+bool AptosBCSWriter::writeFixedBytes(const uint8_t* data, size_t len) {
+    if (!ensureCapacity(len)) return false;
+    if (len > 0) {
+        memcpy(buffer + length, data, len);
+        length += len;
+    }
+    return true;
+}
+
+bool AptosBCSWriter::writeBytes(const uint8_t* data, size_t len) {
+    if (!writeVectorLength(len)) return false;
+    return writeFixedBytes(data, len);
+}
+
+bool AptosBCSWriter::writeString(const char* str, size_t len) {
+    return writeBytes((const uint8_t*)str, len);
+}
+
+bool AptosBCSWriter::writeString(const char* str) {
+    return writeBytes((const uint8_t*)str, strlen(str));
+}
+
+bool AptosBCSWriter::writeString(const String& str) {
+    return writeBytes((const uint8_t*)str.c_str(), str.length());
+}
+
+bool AptosBCSWriter::writeAddress(const uint8_t* address) {
+    return writeFixedBytes(address, BCS_ADDRESS_LENGTH);
+}
+
+bool AptosBCSWriter::writeAddress(const char* hex) {
+    // Short addresses ("0x1") are left-padded with zeros
+    AccountAddress address;
+    if (!address.parse(hex)) {
+        failed = true;
+        return false;
+    }
+    return writeAddress(address.data());
+}
+
+bool AptosBCSWriter::writeAddress(const String& hex) {
+    return writeAddress(hex.c_str());
+}
+
+bool AptosBCSWriter::writeAddress(const AccountAddress& address) {
+    return writeAddress(address.data());
+}
+
+bool AptosBCSWriter::writeOptionNone() {
+    return writeU8(0);
+}
+
+bool AptosBCSWriter::writeOptionSome() {
+    return writeU8(1);
+}
+
+const uint8_t* AptosBCSWriter::data() const {
+    return buffer;
+}
+
+uint8_t* AptosBCSWriter::data() {
+    return buffer;
+}
+
+size_t AptosBCSWriter::size() const {
+    return length;
+}
+
+bool AptosBCSWriter::ok() const {
+    return !failed;
+}
+
+void AptosBCSWriter::clear() {
+    length = 0;
+    failed = false;
+}
+
+String AptosBCSWriter::toHex() const {
+    return AptosUtils::bytesToHex(buffer, length);
+}
+
+size_t AptosBCSWriter::uleb128Size(uint32_t value) {
+    size_t bytes = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
@@ -0,0 +1,81 @@
+#ifndef APTOS_BCS_H
+#define APTOS_BCS_H
+
+#include <Arduino.h>
+#include "AptosAddress.h"
+
+#define BCS_ADDRESS_LENGTH 32
+#define BCS_MAX_ULEB128_LENGTH 5
+
+// Binary Canonical Serialization writer.
+//
+// Appends raw BCS bytes either into a caller-supplied fixed buffer or into a
+// heap buffer that grows geometrically. Every write returns false once the
+// buffer is exhausted (or an allocation fails); the failure is sticky, so a
+// whole struct can be written and checked once with ok().
+//
+// Structs are encoded as the concatenation of their fields in declaration
+// order, enums as a ULEB128 variant index followed by the variant's fields.
+class AptosBCSWriter {
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length;
+    bool ownsBuffer;
+    bool failed;
+
+    bool ensureCapacity(size_t additional);
+
+public:
+    // Constructors. Copies always own a heap buffer holding the same bytes.
+    explicit AptosBCSWriter(size_t initialCapacity = 128);
+    AptosBCSWriter(uint8_t* externalBuffer, size_t bufferSize);
+    AptosBCSWriter(const AptosBCSWriter& other);
+    AptosBCSWriter& operator=(const AptosBCSWriter& other);
+    ~AptosBCSWriter();
+
+    // Unsigned integers (little-endian)
+    bool writeU8(uint8_t value);
+    bool writeU16(uint16_t value);
+    bool writeU32(uint32_t value);
+    bool writeU64(uint64_t value);
+    bool writeU128(uint64_t low, uint64_t high = 0);
+    bool writeU256(const uint8_t* littleEndian);
+    bool writeBool(bool value);
+
+    // Lengths and enum variant indices
+    bool writeUleb128(uint32_t value);
+    bool writeVariantIndex(uint32_t index);
+    bool writeVectorLength(size_t count);
+
+    // Byte sequences
+    bool writeFixedBytes(const uint8_t* data, size_t len);
+    bool writeBytes(const uint8_t* data, size_t len);
+    bool writeString(const char* str, size_t len);
+    bool writeString(const char* str);
+    bool writeString(const String& str);
+
+    // Account addresses (32 raw bytes, no length prefix)
+    bool writeAddress(const uint8_t* address);
+    bool writeAddress(const char* hex);
+    bool writeAddress(const String& hex);
+    bool writeAddress(const AccountAddress& address);
+
+    // Options: tag byte, followed by the value for Some
+    bool writeOptionNone();
+    bool writeOptionSome();
+
+    // Buffer access
+    const uint8_t* data() const;
+    uint8_t* data();
+    size_t size() const;
+    bool ok() const;
+    void clear();
+    bool reserve(size_t totalCapacity);
+    String toHex() const;
+
+    // Encoded size of a ULEB128 value
+    static size_t uleb128Size(uint32_t value);
+};
+
+#endif
@@ -0,0 +1,662 @@
+#include "AptosEd25519.h"
+#include <mbedtls/sha512.h>
+
+// GF(2^255 - 19) element: limb i holds 26 bits for even i, 25 bits for odd i
+typedef int32_t fe[10];
+
+// Extended twisted Edwards coordinates: x = X/Z, y = Y/Z, x*y = T/Z
+struct GePoint {
+    fe X, Y, Z, T;
+};
+
+// Point prepared for repeated addition
+struct GeCached {
+    fe YplusX, YminusX, Z2, T2d;
+};
+
+// Little-endian encodings of the curve constants
+static const uint8_t ED25519_D_BYTES[32] = {
+    0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+    0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52
+};
+
+static const uint8_t ED25519_D2_BYTES[32] = {
+    0x59, 0xf1, 0xb2, 0x26, 0x94, 0x9b, 0xd6, 0xeb, 0x56, 0xb1, 0x83, 0x82, 0x9a, 0x14, 0xe0, 0x00,
+    0x30, 0xd1, 0xf3, 0xee, 0xf2, 0x80, 0x8e, 0x19, 0xe7, 0xfc, 0xdf, 0x56, 0xdc, 0xd9, 0x06, 0x24
+};
+
+static const uint8_t ED25519_SQRTM1_BYTES[32] = {
+    0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+    0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b
+};
+
+static const uint8_t ED25519_BASE_BYTES[32] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66
+};
+
+// Group order L = 2^252 + 27742317777372353535851937790883648493
+static const int64_t ED25519_L[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10
+};
+
+static const int FE_LIMB_OFFSET[10] = {0, 26, 51, 77, 102, 128, 153, 179, 204, 230};
+
+static inline int feLimbBits(int i) {
+    return (i & 1) ? 25 : 26;
+}
+
+static void secureZero(void* data, size_t len) {
+    volatile uint8_t* p = (volatile uint8_t*)data;
+    while (len--) {
+        *p++ = 0;
+    }
+}
+
+// ---- Field arithmetic ----
+
+static void feZero(fe h) {
+    memset(h, 0, sizeof(fe));
+}
+
+static void feOne(fe h) {
+    feZero(h);
+    h[0] = 1;
+}
+
+// Propagates carries so each limb is back within its 25/26-bit range
+static void feCarry(fe h, int64_t* t) {
+    int64_t c;
+    c = (t[0] + (1 << 25)) >> 26; t[1] += c; t[0] -= c * (1 << 26);
+    c = (t[4] + (1 << 25)) >> 26; t[5] += c; t[4] -= c * (1 << 26);
+    c = (t[1] + (1 << 24)) >> 25; t[2] += c; t[1] -= c * (1 << 25);
+    c = (t[5] + (1 << 24)) >> 25; t[6] += c; t[5] -= c * (1 << 25);
+    c = (t[2] + (1 << 25)) >> 26; t[3] += c; t[2] -= c * (1 << 26);
+    c = (t[6] + (1 << 25)) >> 26; t[7] += c; t[6] -= c * (1 << 26);
+    c = (t[3] + (1 << 24)) >> 25; t[4] += c; t[3] -= c * (1 << 25);
+    c = (t[7] + (1 << 24)) >> 25; t[8] += c; t[7] -= c * (1 << 25);
+    c = (t[4] + (1 << 25)) >> 26; t[5] += c; t[4] -= c * (1 << 26);
+    c = (t[8] + (1 << 25)) >> 26; t[9] += c; t[8] -= c * (1 << 26);
+    c = (t[9] + (1 << 24)) >> 25; t[0] += c * 19; t[9] -= c * (1 << 25);
+    c = (t[0] + (1 << 25)) >> 26; t[1] += c; t[0] -= c * (1 << 26);
+
+    for (int i = 0; i < 10; i++) {
+        h[i] = (int32_t)t[i];
+    }
+}
+
+static void feAdd(fe h, const fe f, const fe g) {
+    int64_t t[10];
+    for (int i = 0; i < 10; i++) {
+        t[i] = (int64_t)f[i] + g[i];
+    }
+    feCarry(h, t);
+}
+
+static void feSub(fe h, const fe f, const fe g) {
+    int64_t t[10];
+    for (int i = 0; i < 10; i++) {
+        t[i] = (int64_t)f[i] - g[i];
+    }
+    feCarry(h, t);
+}
+
+static void feNeg(fe h, const fe f) {
+    for (int i = 0; i < 10; i++) {
+        h[i] = -f[i];
+    }
+}
+
+// Schoolbook product. Limb i+j wraps past 2^255 with a factor of 19, and two
+// odd (25-bit) limbs meet at a half-bit offset, hence the extra factor of 2.
+static void feMul(fe h, const fe f, const fe g) {
+    int64_t f2[10], g19[10], t[10];
+    for (int i = 0; i < 10; i++) {
+        f2[i] = (i & 1) ? 2 * (int64_t)f[i] : f[i];
+        g19[i] = 19 * (int64_t)g[i];
+        t[i] = 0;
+    }
+
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            int64_t a = (j & 1) ? f2[i] : f[i];
+            if (i + j < 10) {
+                t[i + j] += a * g[j];
+            } else {
+                t[i + j - 10] += a * g19[j];
+            }
+        }
+    }
+    feCarry(h, t);
+}
+
+static void feSq(fe h, const fe f) {
+    int64_t t[10] = {0};
+    for (int i = 0; i < 10; i++) {
+        for (int j = i; j < 10; j++) {
+            int64_t p = (int64_t)f[i] * f[j];
+            int coefficient = (i == j ? 1 : 2) * ((i & j & 1) ? 2 : 1);
+            if (i + j < 10) {
+                t[i + j] += p * coefficient;
+            } else {
+                t[i + j - 10] += p * (coefficient * 19);
+            }
+        }
+    }
+    feCarry(h, t);
+}
+
+static void feSqTimes(fe h, const fe f, int count) {
+    feSq(h, f);
+    for (int i = 1; i < count; i++) {
+        feSq(h, h);
+    }
+}
+
+static void feFromBytes(fe h, const uint8_t* s) {
+    for (int i = 0; i < 10; i++) {
+        int bit = FE_LIMB_OFFSET[i];
+        int byte = bit >> 3;
+        uint64_t window = 0;
+        for (int k = 0; k < 5 && byte + k < 32; k++) {
+            window |= (uint64_t)s[byte + k] << (8 * k);
+        }
+        // The top limb stops at bit 254; bit 255 is the x sign
+        h[i] = (int32_t)((window >> (bit & 7)) & ((1UL << feLimbBits(i)) - 1));
+    }
+}
+
+// Fully reduces mod p and packs the 255-bit little-endian encoding
+static void feToBytes(uint8_t* s, const fe f) {
+    int32_t h[10];
+    memcpy(h, f, sizeof(h));
+
+    // q = 1 if h >= p, else 0
+    int32_t q = (19 * h[9] + (1 << 24)) >> 25;
+    for (int i = 0; i < 10; i++) {
+        q = (h[i] + q) >> feLimbBits(i);
+    }
+    h[0] += 19 * q;
+
+    for (int i = 0; i < 9; i++) {
+        int32_t c = h[i] >> feLimbBits(i);
+        h[i + 1] += c;
+        h[i] -= c * (1 << feLimbBits(i));
+    }
+    h[9] &= (1 << 25) - 1;
+
+    uint64_t acc = 0;
+    int accBits = 0;
+    size_t out = 0;
+    for (int i = 0; i < 10; i++) {
+        acc |= (uint64_t)(uint32_t)h[i] << accBits;
+        accBits += feLimbBits(i);
+        while (accBits >= 8) {
+            s[out++] = acc & 0xFF;
+            acc >>= 8;
+            accBits -= 8;
+        }
+    }
+    s[out] = (uint8_t)acc;
+}
+
+static bool feIsNegative(const fe f) {
+    uint8_t s[32];
+    feToBytes(s, f);
+    return s[0] & 1;
+}
+
+static bool feIsZero(const fe f) {
+    uint8_t s[32];
+    feToBytes(s, f);
+    uint8_t bits = 0;
+    for (int i = 0; i < 32; i++) {
+        bits |= s[i];
+    }
+    return bits == 0;
+}
+
+// f = g if b == 1, unchanged if b == 0, without branching on b
+static void feCmov(fe f, const fe g, uint32_t b) {
+    int32_t mask = -(int32_t)b;
+    for (int i = 0; i < 10; i++) {
+        f[i] ^= mask & (f[i] ^ g[i]);
+    }
+}
+
+// z^(2^250 - 1), shared by inversion and square roots; also returns z^11
+static void fePow2250(fe out, fe z11, const fe z) {
+    fe t0, t1, t2;
+
+    feSq(t0, z);                    // 2
+    feSqTimes(t1, t0, 2);           // 8
+    feMul(t1, z, t1);               // 9
+    feMul(z11, t0, t1);             // 11
+    feSq(t0, z11);                  // 22
+    feMul(t0, t1, t0);              // 2^5 - 1
+    feSqTimes(t1, t0, 5);
+    feMul(t0, t1, t0);              // 2^10 - 1
+    feSqTimes(t1, t0, 10);
+    feMul(t1, t1, t0);              // 2^20 - 1
+    feSqTimes(t2, t1, 20);
+    feMul(t1, t2, t1);              // 2^40 - 1
+    feSqTimes(t1, t1, 10);
+    feMul(t0, t1, t0);              // 2^50 - 1
+    feSqTimes(t1, t0, 50);
+    feMul(t1, t1, t0);              // 2^100 - 1
+    feSqTimes(t2, t1, 100);
+    feMul(t1, t2, t1);              // 2^200 - 1
+    feSqTimes(t1, t1, 50);
+    feMul(out, t1, t0);             // 2^250 - 1
+}
+
+// z^(p - 2) = z^(2^255 - 21)
+static void feInvert(fe out, const fe z) {
+    fe t, z11;
+    fePow2250(t, z11, z);
+    feSqTimes(t, t, 5);
+    feMul(out, t, z11);
+}
+
+// z^((p - 5) / 8) = z^(2^252 - 3)
+static void fePow22523(fe out, const fe z) {
+    fe t, z11;
+    fePow2250(t, z11, z);
+    feSqTimes(t, t, 2);
+    feMul(out, t, z);
+}
+
+// ---- Curve context ----
+
+struct Ed25519Context {
+    fe d;
+    fe d2;
+    fe sqrtm1;
+    // comb[i] = sum of 2^(64 j) * B over the bits j set in i
+    GeCached comb[16];
+
+    Ed25519Context();
+};
+
+static const Ed25519Context& ed25519Context();
+
+// ---- Group operations ----
+
+static void geIdentity(GePoint& p) {
+    feZero(p.X);
+    feOne(p.Y);
+    feOne(p.Z);
+    feZero(p.T);
+}
+
+static void geCachedIdentity(GeCached& c) {
+    feOne(c.YplusX);
+    feOne(c.YminusX);
+    feOne(c.Z2);
+    c.Z2[0] = 2;
+    feZero(c.T2d);
+}
+
+static void geToCached(GeCached& c, const GePoint& p, const fe d2) {
+    feAdd(c.YplusX, p.Y, p.X);
+    feSub(c.YminusX, p.Y, p.X);
+    feAdd(c.Z2, p.Z, p.Z);
+    feMul(c.T2d, p.T, d2);
+}
+
+// r = p + q (add-2008-hwcd-3, complete for a = -1)
+static void geAdd(GePoint& r, const GePoint& p, const GeCached& q) {
+    fe a, b, c, d, e, f, g, h;
+
+    feSub(a, p.Y, p.X);
+    feMul(a, a, q.YminusX);
+    feAdd(b, p.Y, p.X);
+    feMul(b, b, q.YplusX);
+    feMul(c, p.T, q.T2d);
+    feMul(d, p.Z, q.Z2);
+
+    feSub(e, b, a);
+    feSub(f, d, c);
+    feAdd(g, d, c);
+    feAdd(h, b, a);
+
+    feMul(r.X, e, f);
+    feMul(r.Y, g, h);
+    feMul(r.T, e, h);
+    feMul(r.Z, f, g);
+}
+
+// r = 2p (dbl-2008-hwcd with a = -1)
+static void geDouble(GePoint& r, const GePoint& p) {
+    fe a, b, c, e, f, g, h;
+
+    feSq(a, p.X);
+    feSq(b, p.Y);
+    feSq(c, p.Z);
+    feAdd(c, c, c);
+    feAdd(e, p.X, p.Y);
+    feSq(e, e);
+    feSub(e, e, a);
+    feSub(e, e, b);
+    feSub(g, b, a);
+    feSub(f, g, c);
+    feAdd(h, a, b);
+    feNeg(h, h);
+
+    feMul(r.X, e, f);
+    feMul(r.Y, g, h);
+    feMul(r.T, e, h);
+    feMul(r.Z, f, g);
+}
+
+static void geEncode(uint8_t* s, const GePoint& p) {
+    fe zInverse, x, y;
+    feInvert(zInverse, p.Z);
+    feMul(x, p.X, zInverse);
+    feMul(y, p.Y, zInverse);
+    feToBytes(s, y);
+    s[31] ^= feIsNegative(x) << 7;
+}
+
+// Decodes a point encoding; not constant time (only used on public data)
+static bool geDecode(GePoint& p, const uint8_t* s, const fe d, const fe sqrtm1) {
+    fe u, v, v3, vxx, check;
+
+    feFromBytes(p.Y, s);
+    feOne(p.Z);
+    feSq(u, p.Y);
+    feMul(v, u, d);
+    feSub(u, u, p.Z);               // u = y^2 - 1
+    feAdd(v, v, p.Z);               // v = d y^2 + 1
+
+    // x = u v^3 (u v^7)^((p - 5) / 8)
+    feSq(v3, v);
+    feMul(v3, v3, v);
+    feSq(p.X, v3);
+    feMul(p.X, p.X, v);
+    feMul(p.X, p.X, u);
+    fePow22523(p.X, p.X);
+    feMul(p.X, p.X, v3);
+    feMul(p.X, p.X, u);
+
+    feSq(vxx, p.X);
+    feMul(vxx, vxx, v);
+    feSub(check, vxx, u);
+    if (!feIsZero(check)) {
+        feAdd(check, vxx, u);
+        if (!feIsZero(check)) {
+            return false;
+        }
+        feMul(p.X, p.X, sqrtm1);
+    }
+
+    bool sign = (s[31] >> 7) != 0;
+    if (feIsZero(p.X) && sign) {
+        return false;
+    }
+    if (feIsNegative(p.X) != sign) {
+        feNeg(p.X, p.X);
+    }
+
+    feMul(p.T, p.X, p.Y);
+    return true;
+}
+
+Ed25519Context::Ed25519Context() {
+    feFromBytes(d, ED25519_D_BYTES);
+    feFromBytes(d2, ED25519_D2_BYTES);
+    feFromBytes(sqrtm1, ED25519_SQRTM1_BYTES);
+
+    GePoint base;
+    geDecode(base, ED25519_BASE_BYTES, d, sqrtm1);
+
+    // teeth[j] = 2^(64 j) * B
+    GeCached teeth[4];
+    for (int j = 0; j < 4; j++) {
+        if (j > 0) {
+            for (int k = 0; k < 64; k++) {
+                geDouble(base, base);
+            }
+        }
+        geToCached(teeth[j], base, d2);
+    }
+
+    GePoint sums[16];
+    geIdentity(sums[0]);
+    geCachedIdentity(comb[0]);
+    for (int i = 1; i < 16; i++) {
+        int top = 3;
+        while (!(i & (1 << top))) {
+            top--;
+        }
+        geAdd(sums[i], sums[i & ~(1 << top)], teeth[top]);
+        geToCached(comb[i], sums[i], d2);
+    }
+}
+
+static const Ed25519Context& ed25519Context() {
+    static const Ed25519Context context;
+    return context;
+}
+
+// Reads table[index] touching every entry, so the access pattern does not
+// depend on secret scalar bits
+static void geSelectCached(GeCached& out, const GeCached* table, uint32_t index) {
+    out = table[0];
+    for (uint32_t k = 1; k < 16; k++) {
+        uint32_t equal = ((k ^ index) - 1) >> 31;
+        feCmov(out.YplusX, table[k].YplusX, equal);
+        feCmov(out.YminusX, table[k].YminusX, equal);
+        feCmov(out.Z2, table[k].Z2, equal);
+        feCmov(out.T2d, table[k].T2d, equal);
+    }
+}
+
+// r = scalar * B using the comb: bit i of each 64-bit quarter of the
+// scalar forms the table index for step i
+static void geScalarMultBase(GePoint& r, const uint8_t* scalar) {
+    const Ed25519Context& context = ed25519Context();
+    GeCached selected;
+
+    geIdentity(r);
+    for (int i = 63; i >= 0; i--) {
+        geDouble(r, r);
+
+        uint32_t index = 0;
+        for (int j = 0; j < 4; j++) {
+            int bit = 64 * j + i;
+            index |= ((scalar[bit >> 3] >> (bit & 7)) & 1) << j;
+        }
+        geSelectCached(selected, context.comb, index);
+        geAdd(r, r, selected);
+    }
+}
+
+// r = scalar * p with a 4-bit window; variable time (verification only)
+static void geScalarMultVartime(GePoint& r, const uint8_t* scalar, const GePoint& p) {
+    const Ed25519Context& context = ed25519Context();
+    GeCached table[16];
+    GePoint multiple = p;
+
+    geCachedIdentity(table[0]);
+    geToCached(table[1], p, context.d2);
+    for (int i = 2; i < 16; i++) {
+        geAdd(multiple, multiple, table[1]);
+        geToCached(table[i], multiple, context.d2);
+    }
+
+    geIdentity(r);
+    for (int i = 63; i >= 0; i--) {
+        for (int k = 0; k < 4; k++) {
+            geDouble(r, r);
+        }
+        uint8_t nibble = (scalar[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+        if (nibble) {
+            geAdd(r, r, table[nibble]);
+        }
+    }
+}
+
+// ---- Scalars mod L ----
+
+// Reduces the 64 signed radix-2^8 digits in x mod L into r
+static void scalarModL(uint8_t* r, int64_t* x) {
+    int64_t carry;
+    int i, j;
+
+    for (i = 63; i >= 32; i--) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; j++) {
+            x[j] += carry - 16 * x[i] * ED25519_L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * ED25519_L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * ED25519_L[j];
+    }
+    for (i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = x[i] & 255;
+    }
+}
+
+// Reduces a 64-byte SHA-512 digest mod L
+static void scalarReduce(uint8_t* out, const uint8_t* digest) {
+    int64_t x[64];
+    for (int i = 0; i < 64; i++) {
+        x[i] = digest[i];
+    }
+    scalarModL(out, x);
+}
+
+// out = (a + b * c) mod L
+static void scalarMulAdd(uint8_t* out, const uint8_t* a, const uint8_t* b, const uint8_t* c) {
+    int64_t x[64] = {0};
+    for (int i = 0; i < 32; i++) {
+        x[i] = a[i];
+    }
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            x[i + j] += (int64_t)b[i] * c[j];
+        }
+    }
+    scalarModL(out, x);
+    secureZero(x, sizeof(x));
+}
+
+static bool scalarIsCanonical(const uint8_t* s) {
+    for (int i = 31; i >= 0; i--) {
+        if (s[i] < ED25519_L[i]) return true;
+        if (s[i] > ED25519_L[i]) return false;
+    }
+    return false; // s == L
+}
+
+// SHA-512(part1 || part2 || part3 || part4); empty parts may be null
+static void sha512Parts(uint8_t* digest,
+                        const uint8_t* part1, size_t len1, const uint8_t* part2, size_t len2,
+                        const uint8_t* part3, size_t len3, const uint8_t* part4, size_t len4) {
+    mbedtls_sha512_context ctx;
+    mbedtls_sha512_init(&ctx);
+    mbedtls_sha512_starts(&ctx, 0); // 0 = SHA-512
+    if (len1 > 0) mbedtls_sha512_update(&ctx, part1, len1);
+    if (len2 > 0) mbedtls_sha512_update(&ctx, part2, len2);
+    if (len3 > 0) mbedtls_sha512_update(&ctx, part3, len3);
+    if (len4 > 0) mbedtls_sha512_update(&ctx, part4, len4);
+    mbedtls_sha512_finish(&ctx, digest);
+    mbedtls_sha512_free(&ctx);
+}
+
+// ---- Public API ----
+
+bool AptosEd25519::expandSecret(const uint8_t* seed, uint8_t* scalar, uint8_t* noncePrefix) {
+    uint8_t digest[64];
+    sha512Parts(digest, seed, ED25519_SEED_SIZE, nullptr, 0, nullptr, 0, nullptr, 0);
+
+    digest[0] &= 248;
+    digest[31] &= 127;
+    digest[31] |= 64;
+
+    memcpy(scalar, digest, ED25519_SCALAR_SIZE);
+    memcpy(noncePrefix, digest + 32, 32);
+    secureZero(digest, sizeof(digest));
+    return true;
+}
+
+void AptosEd25519::publicKeyFromScalar(const uint8_t* scalar, uint8_t* publicKey) {
+    GePoint a;
+    geScalarMultBase(a, scalar);
+    geEncode(publicKey, a);
+}
+
+bool AptosEd25519::sign(const uint8_t* scalar, const uint8_t* noncePrefix, const uint8_t* publicKey,
+                        const uint8_t* messagePrefix, size_t messagePrefixLen,
+                        const uint8_t* message, size_t messageLen, uint8_t* signature) {
+    uint8_t digest[64];
+    uint8_t nonce[32];
+    uint8_t challenge[32];
+
+    // r = H(prefix || M) mod L, R = rB
+    sha512Parts(digest, noncePrefix, 32, messagePrefix, messagePrefixLen, message, messageLen, nullptr, 0);
+    scalarReduce(nonce, digest);
+
+    GePoint r;
+    geScalarMultBase(r, nonce);
+    geEncode(signature, r);
+
+    // k = H(R || A || M) mod L, S = r + k a
+    sha512Parts(digest, signature, 32, publicKey, ED25519_PUBLIC_KEY_SIZE,
+                messagePrefix, messagePrefixLen, message, messageLen);
+    scalarReduce(challenge, digest);
+    scalarMulAdd(signature + 32, nonce, challenge, scalar);
+
+    secureZero(digest, sizeof(digest));
+    secureZero(nonce, sizeof(nonce));
+    return true;
+}
+
+bool AptosEd25519::verify(const uint8_t* publicKey,
+                          const uint8_t* messagePrefix, size_t messagePrefixLen,
+                          const uint8_t* message, size_t messageLen, const uint8_t* signature) {
+    const Ed25519Context& context = ed25519Context();
+
+    if (!scalarIsCanonical(signature + 32)) {
+        return false;
+    }
+
+    GePoint a;
+    if (!geDecode(a, publicKey, context.d, context.sqrtm1)) {
+        return false;
+    }
+    feNeg(a.X, a.X);
+    feNeg(a.T, a.T);
+
+    uint8_t digest[64];
+    uint8_t challenge[32];
+    sha512Parts(digest, signature, 32, publicKey, ED25519_PUBLIC_KEY_SIZE,
+                messagePrefix, messagePrefixLen, message, messageLen);
+    scalarReduce(challenge, digest);
+
+    // Check S B - k A == R
+    GePoint sb, ka;
+    GeCached kaCached;
+    geScalarMultBase(sb, signature + 32);
+    geScalarMultVartime(ka, challenge, a);
+    geToCached(kaCached, ka, context.d2);
+    geAdd(sb, sb, kaCached);
+
+    uint8_t expected[32];
+    geEncode(expected, sb);
+    return memcmp(expected, signature, 32) == 0;
+}
@@ -0,0 +1,44 @@
+#ifndef APTOS_ED25519_H
+#define APTOS_ED25519_H
+
+#include <Arduino.h>
+
+#define ED25519_SEED_SIZE 32
+#define ED25519_SCALAR_SIZE 32
+#define ED25519_PUBLIC_KEY_SIZE 32
+#define ED25519_SIGNATURE_SIZE 64
+
+// Ed25519 (RFC 8032) signatures over edwards25519.
+//
+// Field elements use ten signed 25.5-bit limbs so every product fits in a
+// 64-bit accumulator on 32-bit cores. Base point multiplication uses a 4-bit
+// comb over a 16-entry table that is built once on first use, giving 64
+// doublings and 64 additions per signature. Secret-dependent table lookups
+// are done in constant time.
+//
+// Signing works from an expanded secret key (clamped scalar and nonce
+// prefix, both derived from the 32-byte seed with SHA-512). Callers that sign
+// repeatedly should expand once and keep the result, so each signature costs
+// a single base point multiplication plus two SHA-512 passes.
+class AptosEd25519 {
+public:
+    // SHA-512(seed) split into the clamped scalar and the nonce prefix
+    static bool expandSecret(const uint8_t* seed, uint8_t* scalar, uint8_t* noncePrefix);
+
+    // Encoded point scalar * B
+    static void publicKeyFromScalar(const uint8_t* scalar, uint8_t* publicKey);
+
+    // Signs messagePrefix || message without concatenating the two. The
+    // prefix may be null (e.g. for plain messages).
+    static bool sign(const uint8_t* scalar, const uint8_t* noncePrefix, const uint8_t* publicKey,
+                     const uint8_t* messagePrefix, size_t messagePrefixLen,
+                     const uint8_t* message, size_t messageLen, uint8_t* signature);
+
+    // Verifies a signature over messagePrefix || message. Rejects
+    // non-canonical S and public keys that do not decode to a curve point.
+    static bool verify(const uint8_t* publicKey,
+                       const uint8_t* messagePrefix, size_t messagePrefixLen,
+                       const uint8_t* message, size_t messageLen, const uint8_t* signature);
+};
+
+#endif
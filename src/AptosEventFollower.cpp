@@ -0,0 +1,343 @@
+#include "AptosEventFollower.h"
+#include <EEPROM.h>
+
+// Marks a checkpoint table in EEPROM
+#define FOLLOWER_MAGIC_0 'E'
+#define FOLLOWER_MAGIC_1 'F'
+#define FOLLOWER_EEPROM_SIZE 512
+#define FOLLOWER_RECORD_SIZE 12
+
+// FNV-1a: a stream is known by its address and handle across reboots
+static uint32_t streamId(const String& address, const String& key) {
+    uint32_t hash = 2166136261u;
+    String name = address + "/" + key;
+    for (size_t i = 0; i < name.length(); i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+AptosEventFollower::AptosEventFollower(AptosSDK& sdk)
+    : sdk(sdk), pageSize(APTOS_FOLLOWER_DEFAULT_PAGE_SIZE), minIntervalMs(APTOS_FOLLOWER_DEFAULT_MIN_POLL_MS),
+      maxIntervalMs(APTOS_FOLLOWER_DEFAULT_MAX_POLL_MS), callback(nullptr), callbackContext(nullptr),
+      checkpointOffset(-1), forgottenCount(0), checkpointDirty(false), lastSaveMs(0), eventCount(0) {
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        streams[i].used = false;
+        streams[i].generation = 0;
+    }
+}
+
+void AptosEventFollower::setCallback(AptosEventCallback callback, void* context) {
+    this->callback = callback;
+    callbackContext = context;
+}
+
+void AptosEventFollower::setPollInterval(uint32_t minMs, uint32_t maxMs) {
+    minIntervalMs = minMs;
+    maxIntervalMs = maxMs < minMs ? minMs : maxMs;
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        streams[i].intervalMs = minIntervalMs;
+    }
+}
+
+void AptosEventFollower::setPageSize(size_t pageSize) {
+    if (pageSize < 1) {
+        pageSize = 1;
+    }
+    // The node caps event pages at 100
+    this->pageSize = pageSize > 100 ? 100 : pageSize;
+}
+
+int AptosEventFollower::followHandle(const String& address, const String& eventHandle,
+                                     uint64_t startSequenceNumber) {
+    return add(true, address, eventHandle, 0, startSequenceNumber);
+}
+
+int AptosEventFollower::followCreationNumber(const String& address, uint64_t creationNumber,
+                                             uint64_t startSequenceNumber) {
+    return add(false, address, "", creationNumber, startSequenceNumber);
+}
+
+int AptosEventFollower::add(bool byHandle, const String& address, const String& eventHandle,
+                            uint64_t creationNumber, uint64_t startSequenceNumber) {
+    if (!sdk.isValidAddress(address)) {
+        lastError = "Invalid address: " + address;
+        return -1;
+    }
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        Stream& stream = streams[i];
+        if (stream.used) {
+            continue;
+        }
+        stream.used = true;
+        stream.generation++;
+        stream.byHandle = byHandle;
+        stream.address = sdk.normalizeAddress(address);
+        stream.eventHandle = eventHandle;
+        stream.creationNumber = creationNumber;
+        stream.id = streamId(stream.address, byHandle ? eventHandle : AptosUtils::toDecimalString(creationNumber));
+        stream.next = startSequenceNumber;
+        stream.intervalMs = minIntervalMs;
+        stream.lastPollMs = 0;
+        stream.due = true;
+
+        // Followed again: its record is no longer to be erased
+        for (size_t j = 0; j < forgottenCount; j++) {
+            if (forgotten[j] == stream.id) {
+                forgotten[j] = forgotten[--forgottenCount];
+                break;
+            }
+        }
+
+        uint64_t stored;
+        if (checkpointOffset >= 0 && loadCheckpoint(stream.id, stored)) {
+            stream.next = stored;
+        }
+        return (int)i;
+    }
+    lastError = "All streams in use";
+    return -1;
+}
+
+void AptosEventFollower::unfollow(int stream) {
+    if (stream < 0 || stream >= APTOS_FOLLOWER_MAX_STREAMS || !streams[stream].used) {
+        return;
+    }
+    streams[stream].used = false;
+
+    // Its record goes with the next save; a full list is written out first
+    uint32_t id = streams[stream].id;
+    if (forgottenCount == APTOS_FOLLOWER_MAX_STREAMS && checkpointOffset >= 0) {
+        saveCheckpoints();
+    }
+    if (!isForgotten(id) && forgottenCount < APTOS_FOLLOWER_MAX_STREAMS) {
+        forgotten[forgottenCount++] = id;
+    }
+    checkpointDirty = true;
+}
+
+bool AptosEventFollower::isForgotten(uint32_t id) const {
+    for (size_t i = 0; i < forgottenCount; i++) {
+        if (forgotten[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AptosEventFollower::enableCheckpoints(int offset) {
+    if (offset < 0 || offset + 3 + FOLLOWER_RECORD_SIZE * APTOS_FOLLOWER_MAX_STREAMS > FOLLOWER_EEPROM_SIZE) {
+        lastError = "Checkpoint table does not fit in EEPROM";
+        return;
+    }
+    checkpointOffset = offset;
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        uint64_t stored;
+        if (streams[i].used && loadCheckpoint(streams[i].id, stored)) {
+            streams[i].next = stored;
+        }
+    }
+}
+
+// Reads the stored table into ids/next (APTOS_FOLLOWER_MAX_STREAMS records,
+// id 0 when empty); returns the number of records found
+size_t AptosEventFollower::readCheckpoints(uint32_t* ids, uint64_t* next) {
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        ids[i] = 0;
+        next[i] = 0;
+    }
+    EEPROM.begin(FOLLOWER_EEPROM_SIZE);
+    if (EEPROM.read(checkpointOffset) != FOLLOWER_MAGIC_0 ||
+        EEPROM.read(checkpointOffset + 1) != FOLLOWER_MAGIC_1) {
+        return 0;
+    }
+    size_t count = EEPROM.read(checkpointOffset + 2);
+    if (count > APTOS_FOLLOWER_MAX_STREAMS) {
+        count = APTOS_FOLLOWER_MAX_STREAMS;
+    }
+    for (size_t i = 0; i < count; i++) {
+        int record = checkpointOffset + 3 + i * FOLLOWER_RECORD_SIZE;
+        EEPROM.get(record, ids[i]);
+        EEPROM.get(record + 4, next[i]);
+    }
+    return count;
+}
+
+bool AptosEventFollower::loadCheckpoint(uint32_t id, uint64_t& next) {
+    uint32_t ids[APTOS_FOLLOWER_MAX_STREAMS];
+    uint64_t stored[APTOS_FOLLOWER_MAX_STREAMS];
+    size_t count = readCheckpoints(ids, stored);
+    for (size_t i = 0; i < count; i++) {
+        if (ids[i] == id) {
+            next = stored[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AptosEventFollower::saveCheckpoints() {
+    if (checkpointOffset < 0) {
+        return false;
+    }
+
+    // Start from the stored table: streams not followed (yet) keep their
+    // records, unless they were unfollowed
+    uint32_t ids[APTOS_FOLLOWER_MAX_STREAMS];
+    uint64_t next[APTOS_FOLLOWER_MAX_STREAMS];
+    readCheckpoints(ids, next);
+    for (size_t r = 0; r < APTOS_FOLLOWER_MAX_STREAMS; r++) {
+        if (ids[r] != 0 && isForgotten(ids[r])) {
+            ids[r] = 0;
+        }
+    }
+
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        const Stream& stream = streams[i];
+        if (!stream.used) {
+            continue;
+        }
+        // Its own record, else an empty one, else one of a stream not followed;
+        // there are as many records as streams, so one of them is left
+        int slot = -1;
+        for (size_t r = 0; r < APTOS_FOLLOWER_MAX_STREAMS && slot < 0; r++) {
+            if (ids[r] == stream.id) {
+                slot = (int)r;
+            }
+        }
+        for (size_t r = 0; r < APTOS_FOLLOWER_MAX_STREAMS && slot < 0; r++) {
+            if (ids[r] == 0) {
+                slot = (int)r;
+            }
+        }
+        for (size_t r = 0; r < APTOS_FOLLOWER_MAX_STREAMS && slot < 0; r++) {
+            bool followed = false;
+            for (size_t k = 0; k < APTOS_FOLLOWER_MAX_STREAMS; k++) {
+                followed = followed || (streams[k].used && streams[k].id == ids[r]);
+            }
+            if (!followed) {
+                slot = (int)r;
+            }
+        }
+        ids[slot] = stream.id;
+        next[slot] = stream.next;
+    }
+
+    EEPROM.begin(FOLLOWER_EEPROM_SIZE);
+    EEPROM.write(checkpointOffset, FOLLOWER_MAGIC_0);
+    EEPROM.write(checkpointOffset + 1, FOLLOWER_MAGIC_1);
+    EEPROM.write(checkpointOffset + 2, APTOS_FOLLOWER_MAX_STREAMS);
+    for (size_t r = 0; r < APTOS_FOLLOWER_MAX_STREAMS; r++) {
+        int record = checkpointOffset + 3 + r * FOLLOWER_RECORD_SIZE;
+        EEPROM.put(record, ids[r]);
+        EEPROM.put(record + 4, next[r]);
+    }
+    if (!EEPROM.commit()) {
+        lastError = "EEPROM commit failed";
+        return false;
+    }
+    forgottenCount = 0;
+    checkpointDirty = false;
+    lastSaveMs = millis();
+    return true;
+}
+
+int AptosEventFollower::pollStream(Stream& stream) {
+    // Only what follows the checkpoint
+    JsonDocument response;
+    bool ok = stream.byHandle
+        ? sdk.getEventsByEventHandle(stream.address, stream.eventHandle, response, pageSize, stream.next)
+        : sdk.getEventsByCreationNumber(stream.address, stream.creationNumber, response, pageSize, stream.next);
+    if (!ok || !response.is<JsonArray>()) {
+        lastError = AptosUtils::getJsonString(response, "message", "Failed to get events");
+        uint32_t backoff = stream.intervalMs * 2;
+        stream.intervalMs = backoff > maxIntervalMs ? maxIntervalMs : backoff;
+        return 0;
+    }
+
+    // The callback may unfollow this stream and follow another in its slot
+    uint32_t generation = stream.generation;
+    int count = 0;
+    size_t received = 0;
+    for (JsonVariant event : response.as<JsonArray>()) {
+        received++;
+        uint64_t sequenceNumber = AptosUtils::jsonUint64(event["sequence_number"]);
+        if (sequenceNumber < stream.next) {
+            continue;
+        }
+        if (callback != nullptr) {
+            callback((int)(&stream - streams), event, callbackContext);
+        }
+        count++;
+        if (!stream.used || stream.generation != generation) {
+            // Unfollowed from the callback; the slot is not ours any more
+            return count;
+        }
+        stream.next = sequenceNumber + 1;
+        checkpointDirty = true;
+    }
+
+    // Adapt to the stream's rate
+    if (received >= pageSize) {
+        stream.intervalMs = minIntervalMs;
+        stream.due = true;
+    } else if (received > 0) {
+        uint32_t faster = stream.intervalMs / 2;
+        stream.intervalMs = faster < minIntervalMs ? minIntervalMs : faster;
+    } else {
+        uint32_t slower = stream.intervalMs + stream.intervalMs / 2;
+        stream.intervalMs = slower > maxIntervalMs ? maxIntervalMs : slower;
+    }
+    return count;
+}
+
+int AptosEventFollower::poll() {
+    int delivered = 0;
+    for (size_t i = 0; i < APTOS_FOLLOWER_MAX_STREAMS; i++) {
+        Stream& stream = streams[i];
+        if (!stream.used || (!stream.due && millis() - stream.lastPollMs < stream.intervalMs)) {
+            continue;
+        }
+        stream.lastPollMs = millis();
+        stream.due = false;
+        delivered += pollStream(stream);
+    }
+    eventCount += delivered;
+
+    if (checkpointOffset >= 0 && checkpointDirty &&
+        (lastSaveMs == 0 || millis() - lastSaveMs >= APTOS_FOLLOWER_SAVE_INTERVAL_MS)) {
+        saveCheckpoints();
+    }
+    return delivered;
+}
+
+uint64_t AptosEventFollower::getCheckpoint(int stream) const {
+    if (stream < 0 || stream >= APTOS_FOLLOWER_MAX_STREAMS || !streams[stream].used) {
+        return 0;
+    }
+    return streams[stream].next;
+}
+
+void AptosEventFollower::setCheckpoint(int stream, uint64_t nextSequenceNumber) {
+    if (stream < 0 || stream >= APTOS_FOLLOWER_MAX_STREAMS || !streams[stream].used) {
+        return;
+    }
+    streams[stream].next = nextSequenceNumber;
+    streams[stream].due = true;
+    checkpointDirty = true;
+}
+
+uint32_t AptosEventFollower::getInterval(int stream) const {
+    if (stream < 0 || stream >= APTOS_FOLLOWER_MAX_STREAMS || !streams[stream].used) {
+        return 0;
+    }
+    return streams[stream].intervalMs;
+}
+
+uint32_t AptosEventFollower::delivered() const {
+    return eventCount;
+}
+
+String AptosEventFollower::getLastError() const {
+    return lastError;
+}
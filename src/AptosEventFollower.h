@@ -0,0 +1,112 @@
+#ifndef APTOS_EVENT_FOLLOWER_H
+#define APTOS_EVENT_FOLLOWER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "AptosSDK.h"
+
+// Event streams followed at the same time
+#ifndef APTOS_FOLLOWER_MAX_STREAMS
+#define APTOS_FOLLOWER_MAX_STREAMS 4
+#endif
+
+// Defaults, all adjustable at run time
+#define APTOS_FOLLOWER_DEFAULT_PAGE_SIZE 25
+#define APTOS_FOLLOWER_DEFAULT_MIN_POLL_MS 1000
+#define APTOS_FOLLOWER_DEFAULT_MAX_POLL_MS 30000
+
+// Checkpoints in EEPROM: after the account key (saveToEEPROM at offset 0),
+// written at most this often while events keep arriving
+#define APTOS_FOLLOWER_EEPROM_OFFSET 64
+#define APTOS_FOLLOWER_SAVE_INTERVAL_MS 10000
+
+typedef void (*AptosEventCallback)(int stream, JsonVariantConst event, void* context);
+
+// Follows event streams, delivering each event once and in order.
+//
+// Every stream remembers the sequence number of the next event it wants,
+// and poll() asks the node only for events from there on. How often a
+// stream is asked adapts to its traffic: a full page is followed up at
+// once, new events halve the interval (down to the minimum), and each
+// empty poll stretches it by half (up to the maximum).
+//
+// With enableCheckpoints() the position of every stream is kept in EEPROM
+// and restored when the same stream (address and handle) is followed
+// again, so a reboot resumes where it stopped instead of downloading the
+// history again. Saves are throttled to spare the flash; events after the
+// last save may be delivered a second time after a reset. A save updates
+// the streams being followed and keeps the stored positions of the others
+// (not followed again yet after a reboot) unless they were unfollowed;
+// when the table is full, records of streams not followed are replaced.
+class AptosEventFollower {
+private:
+    struct Stream {
+        bool used;
+        bool byHandle;
+        String address;
+        String eventHandle;
+        uint64_t creationNumber;
+        uint32_t id;                // Identifies the stream in the checkpoints
+        uint32_t generation;        // Bumped each time the slot is followed
+        uint64_t next;              // Sequence number of the next event
+        uint32_t intervalMs;
+        unsigned long lastPollMs;
+        bool due;                   // Poll at once, ignoring the interval
+    };
+
+    AptosSDK& sdk;
+    Stream streams[APTOS_FOLLOWER_MAX_STREAMS];
+    size_t pageSize;
+    uint32_t minIntervalMs;
+    uint32_t maxIntervalMs;
+    AptosEventCallback callback;
+    void* callbackContext;
+    int checkpointOffset;           // -1 when checkpoints are off
+    uint32_t forgotten[APTOS_FOLLOWER_MAX_STREAMS];  // Unfollowed, records to erase on the next save
+    size_t forgottenCount;
+    bool checkpointDirty;
+    unsigned long lastSaveMs;
+    uint32_t eventCount;
+    String lastError;
+
+    int add(bool byHandle, const String& address, const String& eventHandle, uint64_t creationNumber,
+            uint64_t startSequenceNumber);
+    size_t readCheckpoints(uint32_t* ids, uint64_t* next);
+    bool loadCheckpoint(uint32_t id, uint64_t& next);
+    bool isForgotten(uint32_t id) const;
+    int pollStream(Stream& stream);
+
+public:
+    AptosEventFollower(AptosSDK& sdk);
+
+    // Configuration
+    void setCallback(AptosEventCallback callback, void* context = nullptr);
+    void setPollInterval(uint32_t minMs, uint32_t maxMs);
+    void setPageSize(size_t pageSize);
+
+    // Starts following a stream from startSequenceNumber, or from its
+    // checkpoint when there is one. Returns the stream number, -1 when all
+    // streams are in use. eventHandle is "<struct type>/<field name>".
+    int followHandle(const String& address, const String& eventHandle, uint64_t startSequenceNumber = 0);
+    int followCreationNumber(const String& address, uint64_t creationNumber, uint64_t startSequenceNumber = 0);
+    void unfollow(int stream);
+
+    // Keeps checkpoints in EEPROM from offset on (3 + 12 bytes per stream)
+    // and moves streams already followed to their stored positions
+    void enableCheckpoints(int offset = APTOS_FOLLOWER_EEPROM_OFFSET);
+    // Writes pending checkpoints now, e.g. before a deep sleep
+    bool saveCheckpoints();
+
+    // Polls the streams that are due and delivers their new events; call it
+    // from loop(). Returns the number of events delivered.
+    int poll();
+
+    // Status
+    uint64_t getCheckpoint(int stream) const;
+    void setCheckpoint(int stream, uint64_t nextSequenceNumber);
+    uint32_t getInterval(int stream) const;
+    uint32_t delivered() const;
+    String getLastError() const;
+};
+
+#endif
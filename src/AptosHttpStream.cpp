@@ -0,0 +1,266 @@
+#include "AptosHttpStream.h"
+#include <limits.h>
+
+// Longest chunk-size line we accept ("ffffffff;ext=...")
+#define CHUNK_LINE_MAX 32
+
+AptosHttpBodyStream::AptosHttpBodyStream(Stream& source, int contentLength, bool chunked, size_t maxBodySize)
+    : source(source), remaining(chunked ? -1 : contentLength), chunked(chunked), chunkRemaining(0),
+      maxBodySize(maxBodySize), delivered(0), finished(false), overflow(false), malformed(false),
+      bufferPos(0), bufferLen(0) {
+}
+
+int AptosHttpBodyStream::readSourceByte() {
+    char c;
+    if (source.readBytes(&c, 1) != 1) {
+        return -1;
+    }
+    return (uint8_t)c;
+}
+
+bool AptosHttpBodyStream::readSourceLine(char* line, size_t maxLength) {
+    size_t len = 0;
+    while (true) {
+        int c = readSourceByte();
+        if (c < 0) {
+            return false;
+        }
+        if (c == '\n') {
+            break;
+        }
+        if (c != '\r' && len + 1 < maxLength) {
+            line[len++] = (char)c;
+        }
+    }
+    line[len] = '\0';
+    return true;
+}
+
+bool AptosHttpBodyStream::nextChunk() {
+    char line[CHUNK_LINE_MAX];
+
+    // Chunk data is followed by CRLF, except before the first chunk
+    if (delivered > 0 && !readSourceLine(line, sizeof(line))) {
+        malformed = true;
+        return false;
+    }
+
+    if (!readSourceLine(line, sizeof(line))) {
+        malformed = true;
+        return false;
+    }
+
+    char* end;
+    unsigned long size = strtoul(line, &end, 16);
+    if (end == line) {
+        malformed = true;
+        return false;
+    }
+
+    if (size == 0) {
+        // Last chunk: skip optional trailers up to the blank line
+        while (readSourceLine(line, sizeof(line)) && line[0] != '\0') {
+        }
+        return false;
+    }
+
+    chunkRemaining = size;
+    return true;
+}
+
+bool AptosHttpBodyStream::fill() {
+    if (bufferPos < bufferLen) {
+        return true;
+    }
+    if (finished) {
+        return false;
+    }
+
+    bufferPos = 0;
+    bufferLen = 0;
+
+    if (chunked && chunkRemaining == 0 && !nextChunk()) {
+        finished = true;
+        return false;
+    }
+    if (!chunked && remaining == 0) {
+        finished = true;
+        return false;
+    }
+
+    if (maxBodySize > 0 && delivered >= maxBodySize) {
+        // More body is pending but the caller's budget is spent
+        overflow = true;
+        finished = true;
+        return false;
+    }
+
+    size_t want = sizeof(buffer);
+    if (chunked && want > chunkRemaining) {
+        want = chunkRemaining;
+    } else if (!chunked && remaining > 0 && want > (size_t)remaining) {
+        want = (size_t)remaining;
+    }
+    if (maxBodySize > 0 && want > maxBodySize - delivered) {
+        want = maxBodySize - delivered;
+    }
+
+    // Take what is already buffered by the socket rather than waiting for a
+    // full block; the last block of a close-delimited body is usually short
+    int ready = source.available();
+    if (ready > 0 && (size_t)ready < want) {
+        want = (size_t)ready;
+    } else if (ready <= 0) {
+        want = 1;
+    }
+
+    size_t n = source.readBytes((char*)buffer, want);
+    if (n == 0) {
+        // Connection closed or timed out; only an error if a length promised more
+        malformed = chunked || remaining > 0;
+        finished = true;
+        return false;
+    }
+
+    bufferLen = n;
+    delivered += n;
+    if (chunked) {
+        chunkRemaining -= n;
+    } else if (remaining > 0) {
+        remaining -= (long)n;
+    }
+    return true;
+}
+
+int AptosHttpBodyStream::available() {
+    if (bufferPos < bufferLen) {
+        return (int)(bufferLen - bufferPos);
+    }
+    return (!finished && source.available() > 0) ? 1 : 0;
+}
+
+int AptosHttpBodyStream::read() {
+    if (!fill()) {
+        return -1;
+    }
+    return buffer[bufferPos++];
+}
+
+int AptosHttpBodyStream::peek() {
+    if (!fill()) {
+        return -1;
+    }
+    return buffer[bufferPos];
+}
+
+size_t AptosHttpBodyStream::readBytes(char* out, size_t length) {
+    size_t copied = 0;
+    while (copied < length && fill()) {
+        size_t n = bufferLen - bufferPos;
+        if (n > length - copied) {
+            n = length - copied;
+        }
+        memcpy(out + copied, buffer + bufferPos, n);
+        bufferPos += n;
+        copied += n;
+    }
+    return copied;
+}
+
+size_t AptosHttpBodyStream::write(uint8_t) {
+    return 0; // Read-only
+}
+
+void AptosHttpBodyStream::drain() {
+    while (fill()) {
+        bufferPos = bufferLen;
+    }
+}
+
+size_t AptosHttpBodyStream::bytesRead() const {
+    return delivered;
+}
+
+bool AptosHttpBodyStream::exceededLimit() const {
+    return overflow;
+}
+
+bool AptosHttpBodyStream::isMalformed() const {
+    return malformed;
+}
+
+AptosBCSVectorStream::AptosBCSVectorStream(const AptosBCSWriter* elements, size_t count)
+    : elements(elements), count(count), prefixLength(0), totalSize(0), position(0),
+      segment(0), segmentOffset(0) {
+    AptosBCSWriter length(prefix, sizeof(prefix));
+    length.writeVectorLength(count);
+    prefixLength = length.size();
+
+    totalSize = prefixLength;
+    for (size_t i = 0; i < count; i++) {
+        totalSize += elements[i].size();
+    }
+}
+
+bool AptosBCSVectorStream::currentSegment(const uint8_t*& data, size_t& length) {
+    // Skips finished (and empty) segments
+    while (segment <= count) {
+        data = segment == 0 ? prefix : elements[segment - 1].data();
+        length = segment == 0 ? prefixLength : elements[segment - 1].size();
+        if (segmentOffset < length) {
+            return true;
+        }
+        segment++;
+        segmentOffset = 0;
+    }
+    return false;
+}
+
+int AptosBCSVectorStream::available() {
+    size_t remaining = totalSize - position;
+    return remaining > INT_MAX ? INT_MAX : (int)remaining;
+}
+
+int AptosBCSVectorStream::read() {
+    const uint8_t* data;
+    size_t length;
+    if (!currentSegment(data, length)) {
+        return -1;
+    }
+    position++;
+    return data[segmentOffset++];
+}
+
+int AptosBCSVectorStream::peek() {
+    const uint8_t* data;
+    size_t length;
+    if (!currentSegment(data, length)) {
+        return -1;
+    }
+    return data[segmentOffset];
+}
+
+size_t AptosBCSVectorStream::readBytes(char* out, size_t length) {
+    size_t copied = 0;
+    const uint8_t* data;
+    size_t segmentLength;
+    while (copied < length && currentSegment(data, segmentLength)) {
+        size_t n = segmentLength - segmentOffset;
+        if (n > length - copied) {
+            n = length - copied;
+        }
+        memcpy(out + copied, data + segmentOffset, n);
+        segmentOffset += n;
+        copied += n;
+    }
+    position += copied;
+    return copied;
+}
+
+size_t AptosBCSVectorStream::write(uint8_t) {
+    return 0;
+}
+
+size_t AptosBCSVectorStream::size() const {
+    return totalSize;
+}
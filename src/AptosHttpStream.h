@@ -0,0 +1,94 @@
+#ifndef APTOS_HTTP_STREAM_H
+#define APTOS_HTTP_STREAM_H
+
+#include <Arduino.h>
+#include "AptosBCS.h"
+
+#define APTOS_HTTP_STREAM_BUFFER_SIZE 64
+
+// Read-only view of an HTTP response body on top of the raw connection.
+//
+// HTTPClient::getStreamPtr() hands back the socket positioned at the start of
+// the body, still chunk-encoded when the server used chunked transfer. This
+// stream strips the chunk framing, stops at Content-Length, and refuses to
+// deliver more than maxBodySize bytes, so the body can be passed straight to
+// deserializeJson() without first being copied into a String.
+//
+// Reads from the socket go through a small buffer, so the parser can pull
+// one byte at a time without one socket call per byte.
+class AptosHttpBodyStream : public Stream {
+private:
+    Stream& source;
+    long remaining;          // Content-Length bytes left, -1 = until close
+    bool chunked;
+    size_t chunkRemaining;
+    size_t maxBodySize;      // 0 = unlimited
+    size_t delivered;
+    bool finished;
+    bool overflow;
+    bool malformed;
+
+    uint8_t buffer[APTOS_HTTP_STREAM_BUFFER_SIZE];
+    size_t bufferPos;
+    size_t bufferLen;
+
+    bool fill();
+    bool nextChunk();
+    int readSourceByte();
+    bool readSourceLine(char* line, size_t maxLength);
+
+public:
+    AptosHttpBodyStream(Stream& source, int contentLength, bool chunked, size_t maxBodySize = 0);
+
+    // Stream interface
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* out, size_t length) override;
+    using Stream::readBytes;
+    size_t write(uint8_t) override;
+
+    // Consumes whatever is left of the body (up to the size limit) so the
+    // connection can be reused for the next request.
+    void drain();
+
+    size_t bytesRead() const;
+    bool exceededLimit() const;
+    bool isMalformed() const;
+};
+
+// Request body holding a BCS vector whose elements were encoded separately,
+// such as the signed transactions of a transactions/batch submission.
+//
+// Reads as ULEB128(count) followed by every element in order, so the
+// vector is sent with HTTPClient::sendRequest(type, stream, size) without
+// first being copied into one buffer.
+class AptosBCSVectorStream : public Stream {
+private:
+    const AptosBCSWriter* elements;
+    size_t count;
+    uint8_t prefix[BCS_MAX_ULEB128_LENGTH];
+    size_t prefixLength;
+    size_t totalSize;
+    size_t position;
+    size_t segment;          // 0 = length prefix, i + 1 = elements[i]
+    size_t segmentOffset;
+
+    bool currentSegment(const uint8_t*& data, size_t& length);
+
+public:
+    AptosBCSVectorStream(const AptosBCSWriter* elements, size_t count);
+
+    // Stream interface
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* out, size_t length) override;
+    using Stream::readBytes;
+    size_t write(uint8_t) override;
+
+    // Encoded size of the whole vector
+    size_t size() const;
+};
+
+#endif
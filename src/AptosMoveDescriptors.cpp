@@ -0,0 +1,13 @@
+#include "AptosMoveDescriptors.h"
+
+APTOS_MOVE_CONSTEXPR const AptosTypeTag APTOS_COIN_TYPE("0x1::aptos_coin::AptosCoin");
+APTOS_MOVE_CONSTEXPR const AptosEntryFunction<1, AccountAddress, uint64_t>
+    APTOS_TRANSFER_COINS("0x1", "aptos_account", "transfer_coins");
+APTOS_MOVE_CONSTEXPR const AptosEntryFunction<0, AccountAddress, uint64_t>
+    APTOS_ACCOUNT_TRANSFER("0x1", "aptos_account", "transfer");
+APTOS_MOVE_CONSTEXPR const AptosEntryFunction<1, AccountAddress, uint64_t>
+    APTOS_COIN_TRANSFER("0x1", "coin", "transfer");
+APTOS_MOVE_CONSTEXPR const AptosEntryFunction<0, AccountAddress>
+    APTOS_CREATE_ACCOUNT("0x1", "aptos_account", "create_account");
+APTOS_MOVE_CONSTEXPR const AptosEntryFunction<0, AccountAddress, String, String, AccountAddress, uint64_t>
+    APTOS_TOKEN_DIRECT_TRANSFER("0x3", "token", "direct_transfer_script");
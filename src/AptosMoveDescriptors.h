@@ -0,0 +1,404 @@
+#ifndef APTOS_MOVE_DESCRIPTORS_H
+#define APTOS_MOVE_DESCRIPTORS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "AptosAddress.h"
+#include "AptosBCS.h"
+
+// BCS enum variant indices (aptos-core types)
+#define PAYLOAD_VARIANT_ENTRY_FUNCTION 2
+
+#define TYPE_TAG_BOOL 0
+#define TYPE_TAG_U8 1
+#define TYPE_TAG_U64 2
+#define TYPE_TAG_U128 3
+#define TYPE_TAG_ADDRESS 4
+#define TYPE_TAG_SIGNER 5
+#define TYPE_TAG_VECTOR 6
+#define TYPE_TAG_STRUCT 7
+#define TYPE_TAG_U16 8
+#define TYPE_TAG_U32 9
+#define TYPE_TAG_U256 10
+
+// Storage of one descriptor: its name as written in JSON payloads and its
+// BCS encoding. Long enough for a long-form address and two 64-character
+// identifiers, or a type tag with a few type arguments.
+#ifndef APTOS_MOVE_NAME_MAX
+#define APTOS_MOVE_NAME_MAX 208
+#endif
+#ifndef APTOS_MOVE_BCS_MAX
+#define APTOS_MOVE_BCS_MAX 192
+#endif
+#define APTOS_MOVE_IDENTIFIER_MAX 64
+
+// Descriptors are parsed by the compiler when it supports C++14 constexpr
+// (loops and assignments in constexpr functions). Under C++11 the same
+// code runs once, when the descriptor is constructed at startup.
+#if __cplusplus >= 201402L
+#define APTOS_MOVE_CONSTEXPR constexpr
+#else
+#define APTOS_MOVE_CONSTEXPR
+#endif
+
+// Reached only when a descriptor does not parse. It is not constexpr, so
+// for a constexpr descriptor the mistake is a compile error naming this
+// function; a descriptor built at run time is left with valid == false.
+inline void aptosInvalidMoveDescriptor() {}
+
+// A name and its BCS bytes, filled in by a constexpr constructor. Declared
+// APTOS_MOVE_CONSTEXPR at namespace scope, a descriptor is parsed by the
+// compiler and its bytes end up in flash (.rodata) rather than being
+// rebuilt in RAM for every transaction.
+class AptosMoveDescriptor {
+public:
+    char name[APTOS_MOVE_NAME_MAX];
+    uint8_t bcs[APTOS_MOVE_BCS_MAX];
+    size_t bcsLength;
+    bool valid;
+
+protected:
+    APTOS_MOVE_CONSTEXPR AptosMoveDescriptor() : name(), bcs(), bcsLength(0), valid(false) {}
+
+    static APTOS_MOVE_CONSTEXPR size_t length(const char* text) {
+        size_t n = 0;
+        while (text[n] != '\0') n++;
+        return n;
+    }
+
+    static APTOS_MOVE_CONSTEXPR int hexDigit(char c) {
+        return (c >= '0' && c <= '9') ? c - '0' :
+               (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+               (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+    }
+
+    static APTOS_MOVE_CONSTEXPR bool identifierChar(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    static APTOS_MOVE_CONSTEXPR size_t tokenLength(const char* p, const char* end) {
+        size_t n = 0;
+        while (p + n < end && identifierChar(p[n])) n++;
+        return n;
+    }
+
+    static APTOS_MOVE_CONSTEXPR bool tokenEquals(const char* token, size_t len, const char* word) {
+        for (size_t i = 0; i < len; i++) {
+            if (word[i] != token[i]) return false;
+        }
+        return word[len] == '\0';
+    }
+
+    static APTOS_MOVE_CONSTEXPR void skipSpaces(const char*& p, const char* end) {
+        while (p < end && *p == ' ') p++;
+    }
+
+    APTOS_MOVE_CONSTEXPR bool put(uint8_t value) {
+        if (bcsLength >= APTOS_MOVE_BCS_MAX) return false;
+        bcs[bcsLength++] = value;
+        return true;
+    }
+
+    APTOS_MOVE_CONSTEXPR bool putName(const char* text, size_t len, size_t& at) {
+        if (at + len >= APTOS_MOVE_NAME_MAX) return false;
+        for (size_t i = 0; i < len; i++) name[at++] = text[i];
+        return true;
+    }
+
+    // 32 raw bytes, short forms left-padded as in AccountAddress::parse
+    APTOS_MOVE_CONSTEXPR bool putAddress(const char* hex, size_t len) {
+        if (len >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+            hex += 2;
+            len -= 2;
+        }
+        if (len == 0 || len > ACCOUNT_ADDRESS_LENGTH * 2 || bcsLength + ACCOUNT_ADDRESS_LENGTH > APTOS_MOVE_BCS_MAX) {
+            return false;
+        }
+        uint8_t* out = bcs + bcsLength;
+        size_t pos = ACCOUNT_ADDRESS_LENGTH * 2 - len;
+        for (size_t i = 0; i < len; i++, pos++) {
+            int nibble = hexDigit(hex[i]);
+            if (nibble < 0) return false;
+            out[pos / 2] |= (pos & 1) ? nibble : (nibble << 4);
+        }
+        bcsLength += ACCOUNT_ADDRESS_LENGTH;
+        return true;
+    }
+
+    // BCS String; Move identifiers are short enough for a one-byte length
+    APTOS_MOVE_CONSTEXPR bool putIdentifier(const char* text, size_t len) {
+        if (len == 0 || len > APTOS_MOVE_IDENTIFIER_MAX || (text[0] >= '0' && text[0] <= '9') || !put(len)) {
+            return false;
+        }
+        for (size_t i = 0; i < len; i++) {
+            if (!identifierChar(text[i]) || !put(text[i])) return false;
+        }
+        return true;
+    }
+
+    // Same grammar as AptosTransaction::serializeTypeTag
+    APTOS_MOVE_CONSTEXPR bool putTypeTag(const char*& p, const char* end, int depth) {
+        skipSpaces(p, end);
+        const char* token = p;
+        size_t len = tokenLength(p, end);
+        if (len == 0 || depth > 8) return false;
+        p += len;
+
+        if (p + 1 < end && p[0] == ':' && p[1] == ':') {
+            // Struct tag: address::module::name<type_params>
+            if (!put(TYPE_TAG_STRUCT) || !putAddress(token, len)) return false;
+            for (int part = 0; part < 2; part++) {
+                if (p + 1 >= end || p[0] != ':' || p[1] != ':') return false;
+                p += 2;
+                size_t identLen = tokenLength(p, end);
+                if (!putIdentifier(p, identLen)) return false;
+                p += identLen;
+            }
+            skipSpaces(p, end);
+            if (p >= end || *p != '<') {
+                return put(0);
+            }
+            return putTypeTagList(p, end, depth);
+        }
+
+        if (tokenEquals(token, len, "vector")) {
+            skipSpaces(p, end);
+            if (p >= end || *p != '<' || !put(TYPE_TAG_VECTOR)) return false;
+            p++;
+            if (!putTypeTag(p, end, depth + 1)) return false;
+            skipSpaces(p, end);
+            if (p >= end || *p != '>') return false;
+            p++;
+            return true;
+        }
+
+        return tokenEquals(token, len, "bool") ? put(TYPE_TAG_BOOL) :
+               tokenEquals(token, len, "u8") ? put(TYPE_TAG_U8) :
+               tokenEquals(token, len, "u16") ? put(TYPE_TAG_U16) :
+               tokenEquals(token, len, "u32") ? put(TYPE_TAG_U32) :
+               tokenEquals(token, len, "u64") ? put(TYPE_TAG_U64) :
+               tokenEquals(token, len, "u128") ? put(TYPE_TAG_U128) :
+               tokenEquals(token, len, "u256") ? put(TYPE_TAG_U256) :
+               tokenEquals(token, len, "address") ? put(TYPE_TAG_ADDRESS) :
+               tokenEquals(token, len, "signer") ? put(TYPE_TAG_SIGNER) : false;
+    }
+
+    APTOS_MOVE_CONSTEXPR bool putTypeTagList(const char*& p, const char* end, int depth) {
+        // Counts the entries of "<A, B<C>, D>" first: the vector length precedes them
+        size_t count = 0;
+        int nesting = 0;
+        for (const char* q = p; q < end; q++) {
+            if (*q == '<') {
+                if (nesting++ == 0) count = 1;
+            } else if (*q == '>') {
+                if (--nesting == 0) break;
+            } else if (*q == ',' && nesting == 1) {
+                count++;
+            }
+        }
+        if (nesting != 0 || count == 0 || count > 127 || !put(count)) {
+            return false;
+        }
+
+        p++; // '<'
+        for (size_t i = 0; i < count; i++) {
+            if (!putTypeTag(p, end, depth + 1)) return false;
+            skipSpaces(p, end);
+            if (p >= end || *p != (i + 1 < count ? ',' : '>')) return false;
+            p++;
+        }
+        return true;
+    }
+
+    static APTOS_MOVE_CONSTEXPR void check(bool ok) {
+        if (!ok) aptosInvalidMoveDescriptor();
+    }
+
+    APTOS_MOVE_CONSTEXPR void fail() {
+        bcsLength = 0;
+        name[0] = '\0';
+        valid = false;
+        check(valid);
+    }
+};
+
+// A Move type tag ("u64", "vector<u8>", "0x1::aptos_coin::AptosCoin",
+// "0x1::coin::CoinStore<0x1::aptos_coin::AptosCoin>"), encoded once:
+//
+//   APTOS_MOVE_CONSTEXPR AptosTypeTag USDC("0xf22b...::asset::USDC");
+//   txn.coinTransfer(recipient, amount, USDC);
+class AptosTypeTag : public AptosMoveDescriptor {
+public:
+    APTOS_MOVE_CONSTEXPR AptosTypeTag(const char* text) : AptosMoveDescriptor() {
+        size_t len = length(text);
+        const char* p = text;
+        const char* end = text + len;
+        size_t at = 0;
+        if (!putName(text, len, at) || !putTypeTag(p, end, 0)) {
+            fail();
+            return;
+        }
+        skipSpaces(p, end);
+        if (p != end) {
+            fail();
+            return;
+        }
+        valid = true;
+    }
+};
+
+// An entry function with its argument types:
+//
+//   APTOS_MOVE_CONSTEXPR AptosEntryFunction<0, AccountAddress, uint64_t>
+//       MINT("0xcafe", "token", "mint");
+//   txn.entryFunction(MINT, {}, recipient, 100);
+//
+// TypeArgCount is the number of type arguments the function takes, Args
+// its arguments after the signer; AptosTransaction::entryFunction() only
+// compiles with that many type arguments and values convertible to Args.
+// The name is in the long form ("0x" + 64 digits) used in JSON payloads;
+// the BCS bytes are the EntryFunction variant index, ModuleId and
+// function name, ready to be followed by the type and value arguments.
+template <size_t TypeArgCount, typename... Args>
+class AptosEntryFunction : public AptosMoveDescriptor {
+public:
+    APTOS_MOVE_CONSTEXPR AptosEntryFunction(const char* address, const char* module, const char* function)
+        : AptosMoveDescriptor() {
+        size_t moduleLength = length(module);
+        size_t functionLength = length(function);
+        if (!put(PAYLOAD_VARIANT_ENTRY_FUNCTION) || !putAddress(address, length(address)) ||
+            !putIdentifier(module, moduleLength) || !putIdentifier(function, functionLength)) {
+            fail();
+            return;
+        }
+
+        // "0x" + the address bytes just written, then "::module::function"
+        size_t at = 0;
+        name[at++] = '0';
+        name[at++] = 'x';
+        for (size_t i = 1; i <= ACCOUNT_ADDRESS_LENGTH; i++) {
+            name[at++] = "0123456789abcdef"[bcs[i] >> 4];
+            name[at++] = "0123456789abcdef"[bcs[i] & 0x0F];
+        }
+        if (!putName("::", 2, at) || !putName(module, moduleLength, at) ||
+            !putName("::", 2, at) || !putName(function, functionLength, at)) {
+            fail();
+            return;
+        }
+        valid = true;
+    }
+};
+
+// One type argument: a descriptor, or a String parsed when it is used
+class AptosTypeArg {
+public:
+    const AptosTypeTag* tag;
+    const String* text;
+
+    AptosTypeArg() : tag(nullptr), text(nullptr) {}
+    AptosTypeArg(const AptosTypeTag& tag) : tag(&tag), text(nullptr) {}
+    AptosTypeArg(const String& text) : tag(nullptr), text(&text) {}
+};
+
+// Type arguments of a call, written as a braced list: {APTOS_COIN_TYPE}.
+// More entries than the function takes do not compile.
+template <size_t Count>
+struct AptosTypeArgs {
+    AptosTypeArg args[Count];
+};
+
+// No type arguments: only {} converts
+template <>
+struct AptosTypeArgs<0> {
+    const AptosTypeArg* args;
+};
+
+// Argument types an AptosEntryFunction can take. Each one appends its
+// value to the JSON arguments and its BCS encoding (as the vector<u8> an
+// entry function argument is) to the payload. Other types do not compile.
+template <typename T>
+struct AptosMoveArg;
+
+template <>
+struct AptosMoveArg<bool> {
+    typedef bool Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, bool value) {
+        json.add(value);
+        bcs.writeVectorLength(1);
+        return bcs.writeBool(value);
+    }
+};
+
+template <>
+struct AptosMoveArg<uint8_t> {
+    typedef uint8_t Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, uint8_t value) {
+        json.add(value);
+        bcs.writeVectorLength(1);
+        return bcs.writeU8(value);
+    }
+};
+
+template <>
+struct AptosMoveArg<uint16_t> {
+    typedef uint16_t Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, uint16_t value) {
+        json.add(value);
+        bcs.writeVectorLength(2);
+        return bcs.writeU16(value);
+    }
+};
+
+template <>
+struct AptosMoveArg<uint32_t> {
+    typedef uint32_t Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, uint32_t value) {
+        json.add(value);
+        bcs.writeVectorLength(4);
+        return bcs.writeU32(value);
+    }
+};
+
+template <>
+struct AptosMoveArg<uint64_t> {
+    typedef uint64_t Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, uint64_t value) {
+        // u64 goes into JSON as a decimal string
+        json.add(String(value));
+        bcs.writeVectorLength(8);
+        return bcs.writeU64(value);
+    }
+};
+
+template <>
+struct AptosMoveArg<AccountAddress> {
+    typedef AccountAddress Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, const AccountAddress& value) {
+        json.add(value.toString());
+        bcs.writeVectorLength(ACCOUNT_ADDRESS_LENGTH);
+        return bcs.writeAddress(value);
+    }
+};
+
+template <>
+struct AptosMoveArg<String> {
+    typedef String Value;
+    static bool write(AptosBCSWriter& bcs, JsonArray& json, const String& value) {
+        json.add(value);
+        bcs.writeVectorLength(AptosBCSWriter::uleb128Size(value.length()) + value.length());
+        return bcs.writeString(value);
+    }
+};
+
+// Framework types and functions used by the prebuilt transactions, defined
+// once in AptosMoveDescriptors.cpp
+extern const AptosTypeTag APTOS_COIN_TYPE;
+extern const AptosEntryFunction<1, AccountAddress, uint64_t> APTOS_TRANSFER_COINS;
+extern const AptosEntryFunction<0, AccountAddress, uint64_t> APTOS_ACCOUNT_TRANSFER;
+extern const AptosEntryFunction<1, AccountAddress, uint64_t> APTOS_COIN_TRANSFER;
+extern const AptosEntryFunction<0, AccountAddress> APTOS_CREATE_ACCOUNT;
+// Argument order as used by AptosTransaction::tokenTransfer
+extern const AptosEntryFunction<0, AccountAddress, String, String, AccountAddress, uint64_t>
+    APTOS_TOKEN_DIRECT_TRANSFER;
+
+#endif
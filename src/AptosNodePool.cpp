@@ -0,0 +1,191 @@
+#include "AptosNodePool.h"
+
+AptosNodePool::AptosNodePool(const String& url) : count(0), stickyIndex(-1), readCounter(0) {
+    reset(url);
+}
+
+void AptosNodePool::init(Node& node, const String& url) {
+    node.url = url;
+    node.latencyMs = 0;
+    node.measured = false;
+    node.requests = 0;
+    node.failures = 0;
+    node.consecutiveFailures = 0;
+    node.refused = false;
+    node.downUntil = 0;
+    node.lastUsedMs = 0;
+    node.sampleCount = 0;
+    node.nextSample = 0;
+}
+
+void AptosNodePool::reset(const String& url) {
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < APTOS_NODE_MAX; i++) {
+        nodes[i].url = String();
+    }
+    count = 0;
+    stickyIndex = -1;
+    readCounter = 0;
+
+    init(nodes[count++], url);
+}
+
+bool AptosNodePool::add(const String& url) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (count >= APTOS_NODE_MAX) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (nodes[i].url == url) {
+            return false;
+        }
+    }
+
+    init(nodes[count++], url);
+    return true;
+}
+
+size_t AptosNodePool::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return count;
+}
+
+bool AptosNodePool::healthy(const Node& node, unsigned long now) const {
+    return node.consecutiveFailures == 0 || (long)(now - node.downUntil) >= 0;
+}
+
+int AptosNodePool::fastest(uint32_t tried, unsigned long now) const {
+    int best = -1;
+    for (size_t i = 0; i < count; i++) {
+        if ((tried & (1u << i)) || !healthy(nodes[i], now)) {
+            continue;
+        }
+        if (!nodes[i].measured) {
+            return (int)i;
+        }
+        if (best < 0 || nodes[i].latencyMs < nodes[best].latencyMs) {
+            best = (int)i;
+        }
+    }
+    return best;
+}
+
+int AptosNodePool::pick(bool sticky, uint32_t tried) {
+    std::lock_guard<std::mutex> guard(lock);
+    unsigned long now = millis();
+
+    // Submissions stay put through timeouts and error answers, even while
+    // the node backs off for reads
+    if (sticky && stickyIndex >= 0 && !(tried & (1u << stickyIndex)) && !nodes[stickyIndex].refused) {
+        return stickyIndex;
+    }
+
+    int chosen = fastest(tried, now);
+    if (!sticky && chosen >= 0 && ++readCounter % APTOS_NODE_PROBE_EVERY == 0) {
+        for (size_t i = 0; i < count; i++) {
+            if (!(tried & (1u << i)) && healthy(nodes[i], now) && nodes[i].lastUsedMs < nodes[chosen].lastUsedMs) {
+                chosen = (int)i;
+            }
+        }
+    }
+
+    if (chosen < 0) {
+        // Everything is backing off: take the node that recovers first
+        // rather than failing without a request
+        for (size_t i = 0; i < count; i++) {
+            if (!(tried & (1u << i)) &&
+                (chosen < 0 || (long)(nodes[i].downUntil - nodes[chosen].downUntil) < 0)) {
+                chosen = (int)i;
+            }
+        }
+    }
+
+    if (sticky && chosen >= 0) {
+        stickyIndex = chosen;
+    }
+    return chosen;
+}
+
+bool AptosNodePool::untried(uint32_t tried) const {
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < count; i++) {
+        if (!(tried & (1u << i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+String AptosNodePool::url(int index) const {
+    std::lock_guard<std::mutex> guard(lock);
+    return index >= 0 && (size_t)index < count ? nodes[index].url : String();
+}
+
+void AptosNodePool::report(int index, bool ok, uint32_t latencyMs, bool refused) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (index < 0 || (size_t)index >= count) {
+        return;
+    }
+    Node& node = nodes[index];
+    node.requests++;
+    node.lastUsedMs = millis();
+    node.refused = !ok && refused;
+
+    if (ok) {
+        // Exponential moving average, weighted 1/4 towards the new sample
+        node.latencyMs = node.measured ? (node.latencyMs * 3 + latencyMs) / 4 : latencyMs;
+        node.measured = true;
+        node.consecutiveFailures = 0;
+        node.samples[node.nextSample] = latencyMs > UINT16_MAX ? UINT16_MAX : (uint16_t)latencyMs;
+        node.nextSample = (node.nextSample + 1) % APTOS_NODE_SAMPLES;
+        if (node.sampleCount < APTOS_NODE_SAMPLES) {
+            node.sampleCount++;
+        }
+        return;
+    }
+
+    node.failures++;
+    node.consecutiveFailures++;
+    uint32_t backoff = APTOS_NODE_BACKOFF_MS;
+    for (uint32_t i = 1; i < node.consecutiveFailures && backoff < APTOS_NODE_MAX_BACKOFF_MS; i++) {
+        backoff *= 2;
+    }
+    node.downUntil = node.lastUsedMs + (backoff < APTOS_NODE_MAX_BACKOFF_MS ? backoff : APTOS_NODE_MAX_BACKOFF_MS);
+}
+
+uint32_t AptosNodePool::percentile(int index, uint8_t pct) const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (index < 0 || (size_t)index >= count || nodes[index].sampleCount < APTOS_NODE_MIN_SAMPLES) {
+        return 0;
+    }
+
+    // Insertion sort; there are at most APTOS_NODE_SAMPLES values
+    const Node& node = nodes[index];
+    uint16_t sorted[APTOS_NODE_SAMPLES];
+    size_t n = node.sampleCount;
+    for (size_t i = 0; i < n; i++) {
+        uint16_t value = node.samples[i];
+        size_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    return sorted[(n - 1) * (pct > 100 ? 100 : pct) / 100];
+}
+
+bool AptosNodePool::stats(size_t index, AptosNodeStats& stats) const {
+    std::lock_guard<std::mutex> guard(lock);
+    if (index >= count) {
+        return false;
+    }
+    const Node& node = nodes[index];
+    stats.url = node.url;
+    stats.latencyMs = node.latencyMs;
+    stats.requests = node.requests;
+    stats.failures = node.failures;
+    stats.healthy = healthy(node, millis());
+    stats.submissions = stickyIndex == (int)index;
+    return true;
+}
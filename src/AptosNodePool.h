@@ -0,0 +1,103 @@
+#ifndef APTOS_NODE_POOL_H
+#define APTOS_NODE_POOL_H
+
+#include <Arduino.h>
+#include <mutex>
+
+// Upper bound for the number of fullnodes one AptosSDK talks to
+#ifndef APTOS_NODE_MAX
+#define APTOS_NODE_MAX 4
+#endif
+
+// Every this many reads one goes to the least recently used healthy node,
+// so the latency of the others stays current
+#ifndef APTOS_NODE_PROBE_EVERY
+#define APTOS_NODE_PROBE_EVERY 16
+#endif
+
+// Recent latencies kept per node for percentile(); fewer than
+// APTOS_NODE_MIN_SAMPLES give no percentile
+#ifndef APTOS_NODE_SAMPLES
+#define APTOS_NODE_SAMPLES 32
+#endif
+#define APTOS_NODE_MIN_SAMPLES 8
+
+// A failed node is skipped for this long, doubling per consecutive failure
+#define APTOS_NODE_BACKOFF_MS 2000
+#define APTOS_NODE_MAX_BACKOFF_MS 60000
+
+struct AptosNodeStats {
+    String url;
+    uint32_t latencyMs;     // Smoothed time to the response headers, 0 until measured
+    uint32_t requests;
+    uint32_t failures;      // Transport errors, 429 and 5xx answers
+    bool healthy;           // False while backing off after a failure
+    bool submissions;       // The node submissions currently stick to
+};
+
+// Picks a fullnode for each request.
+//
+// Reads go to the healthy node with the lowest smoothed latency; a node
+// that has not answered yet is tried first, and an occasional probe keeps
+// the other scores fresh. Submissions (and the reads that must agree with
+// them) stick to one node, which only changes when it refuses a connection:
+// after a timeout or an error answer it may still have the transaction, and
+// posting the same bytes elsewhere would reach a second mempool. A failing
+// node backs off exponentially; when every node is backing off the one
+// that recovers first is still used. All methods are safe to call from
+// several tasks.
+class AptosNodePool {
+private:
+    struct Node {
+        String url;
+        uint32_t latencyMs;
+        bool measured;
+        uint32_t requests;
+        uint32_t failures;
+        uint32_t consecutiveFailures;
+        bool refused;               // The last attempt could not connect
+        unsigned long downUntil;
+        unsigned long lastUsedMs;
+        uint16_t samples[APTOS_NODE_SAMPLES];
+        uint8_t sampleCount;
+        uint8_t nextSample;
+    };
+
+    Node nodes[APTOS_NODE_MAX];
+    size_t count;
+    int stickyIndex;
+    uint32_t readCounter;
+    mutable std::mutex lock;
+
+    static void init(Node& node, const String& url);
+    bool healthy(const Node& node, unsigned long now) const;
+    int fastest(uint32_t tried, unsigned long now) const;
+
+public:
+    AptosNodePool(const String& url);
+
+    // Replaces all nodes with url
+    void reset(const String& url);
+
+    // False if the pool is full or url is already in it
+    bool add(const String& url);
+    size_t size() const;
+
+    // Index of the node for the next attempt; tried is a bit mask of the
+    // nodes already used for this request. -1 once every node was tried.
+    int pick(bool sticky, uint32_t tried);
+    bool untried(uint32_t tried) const;
+    String url(int index) const;
+
+    // Outcome of one request; a failure starts the node's back-off, and
+    // only a refused connection moves submissions to another node
+    void report(int index, bool ok, uint32_t latencyMs, bool refused = false);
+
+    // Latency in ms that pct percent of the node's recent answers beat;
+    // 0 while there are too few samples
+    uint32_t percentile(int index, uint8_t pct) const;
+
+    bool stats(size_t index, AptosNodeStats& stats) const;
+};
+
+#endif
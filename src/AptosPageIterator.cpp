@@ -0,0 +1,232 @@
+#include "AptosPageIterator.h"
+#ifdef ESP32
+#include <esp_pthread.h>
+#endif
+
+AptosPageIterator::AptosPageIterator(AptosSDK& sdk, size_t pageSize)
+    : sdk(sdk), source(APTOS_PAGES_NONE), ledgerVersion(0), pageSize(APTOS_PAGE_DEFAULT_SIZE),
+      prefetch(true), filter(nullptr), current(0), nextNumber(0), requested(false), exhausted(true),
+      error(false), pageCount(0), itemCount(0) {
+    pages[0].ok = false;
+    pages[1].ok = false;
+    setPageSize(pageSize);
+}
+
+AptosPageIterator::~AptosPageIterator() {
+    end();
+}
+
+void AptosPageIterator::setPageSize(size_t pageSize) {
+    if (pageSize < 1) {
+        pageSize = 1;
+    }
+    this->pageSize = pageSize > APTOS_PAGE_MAX_SIZE ? APTOS_PAGE_MAX_SIZE : pageSize;
+}
+
+void AptosPageIterator::setPrefetch(bool enabled) {
+    prefetch = enabled;
+}
+
+void AptosPageIterator::setFilter(const JsonDocument* filter) {
+    this->filter = filter;
+}
+
+void AptosPageIterator::transactions(uint64_t startVersion) {
+    reset(APTOS_PAGES_TRANSACTIONS, "", "", startVersion, 0);
+}
+
+void AptosPageIterator::accountTransactions(const String& address, uint64_t startSequenceNumber) {
+    reset(APTOS_PAGES_ACCOUNT_TRANSACTIONS, address, "", startSequenceNumber, 0);
+}
+
+void AptosPageIterator::accountResources(const String& address, uint64_t ledgerVersion) {
+    reset(APTOS_PAGES_ACCOUNT_RESOURCES, address, "", 0, ledgerVersion);
+}
+
+void AptosPageIterator::accountModules(const String& address, uint64_t ledgerVersion) {
+    reset(APTOS_PAGES_ACCOUNT_MODULES, address, "", 0, ledgerVersion);
+}
+
+void AptosPageIterator::eventsByHandle(const String& address, const String& eventHandle,
+                                       uint64_t startSequenceNumber) {
+    reset(APTOS_PAGES_EVENTS_BY_HANDLE, address, eventHandle, startSequenceNumber, 0);
+}
+
+void AptosPageIterator::eventsByCreationNumber(const String& address, uint64_t creationNumber,
+                                               uint64_t startSequenceNumber) {
+    reset(APTOS_PAGES_EVENTS_BY_CREATION_NUMBER, address, AptosUtils::toDecimalString(creationNumber), startSequenceNumber, 0);
+}
+
+void AptosPageIterator::reset(AptosPageSource source, const String& address, const String& key,
+                              uint64_t start, uint64_t ledgerVersion) {
+    end();
+    this->source = source;
+    this->address = address.isEmpty() ? address : sdk.normalizeAddress(address);
+    this->key = key;
+    this->ledgerVersion = ledgerVersion;
+    nextStart = "";
+    nextNumber = start;
+    exhausted = false;
+    error = false;
+    pageCount = 0;
+    itemCount = 0;
+    lastError = "";
+
+    // The first page is on its way while the caller gets ready
+    request();
+}
+
+String AptosPageIterator::endpoint() const {
+    String endpoint;
+    bool cursorOnly = false;
+    switch (source) {
+        case APTOS_PAGES_TRANSACTIONS:
+            endpoint = "transactions";
+            break;
+        case APTOS_PAGES_ACCOUNT_TRANSACTIONS:
+            endpoint = "accounts/" + address + "/transactions";
+            break;
+        case APTOS_PAGES_ACCOUNT_RESOURCES:
+            endpoint = "accounts/" + address + "/resources";
+            cursorOnly = true;
+            break;
+        case APTOS_PAGES_ACCOUNT_MODULES:
+            endpoint = "accounts/" + address + "/modules";
+            cursorOnly = true;
+            break;
+        case APTOS_PAGES_EVENTS_BY_HANDLE:
+        case APTOS_PAGES_EVENTS_BY_CREATION_NUMBER:
+            endpoint = "accounts/" + address + "/events/" + key;
+            break;
+        default:
+            return "";
+    }
+
+    endpoint += "?limit=" + String((unsigned long)pageSize);
+    if (!nextStart.isEmpty()) {
+        endpoint += "&start=" + nextStart;
+    } else if (!cursorOnly) {
+        endpoint += "&start=" + AptosUtils::toDecimalString(nextNumber);
+    }
+    if (ledgerVersion > 0) {
+        endpoint += "&ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
+    }
+    return endpoint;
+}
+
+void AptosPageIterator::request() {
+    pending = endpoint();
+    requested = true;
+    if (!prefetch) {
+        // Fetched on demand in wait()
+        return;
+    }
+
+    Page& page = pages[1 - current];
+    String url = pending;
+#ifdef ESP32
+    // HTTPClient (and TLS) need more than the default pthread stack
+    esp_pthread_cfg_t config = esp_pthread_get_default_config();
+    config.stack_size = APTOS_PAGE_STACK_SIZE;
+    esp_pthread_set_cfg(&config);
+#endif
+    worker = std::thread([this, &page, url]() {
+        page.ok = sdk.fetchPage(url, page.items, page.cursor, filter);
+    });
+}
+
+void AptosPageIterator::wait() {
+    if (worker.joinable()) {
+        worker.join();
+    } else {
+        Page& page = pages[1 - current];
+        page.ok = sdk.fetchPage(pending, page.items, page.cursor, filter);
+    }
+    requested = false;
+}
+
+bool AptosPageIterator::advance() {
+    while (!exhausted && !error) {
+        if (!requested) {
+            request();
+        }
+        wait();
+
+        Page& page = pages[1 - current];
+        if (!page.ok || !page.items.is<JsonArray>()) {
+            error = true;
+            lastError = AptosUtils::getJsonString(page.items, "message", "Failed to fetch page");
+            return false;
+        }
+
+        // The old page is overwritten by the next prefetch
+        current = 1 - current;
+        pageCount++;
+        JsonArrayConst items = page.items.as<JsonArrayConst>();
+        position = items.begin();
+        stop = items.end();
+
+        size_t count = items.size();
+        bool cursorOnly = source == APTOS_PAGES_ACCOUNT_RESOURCES || source == APTOS_PAGES_ACCOUNT_MODULES;
+        nextStart = page.cursor;
+        nextNumber += count;
+        if (nextStart.isEmpty() && (cursorOnly || count < pageSize)) {
+            exhausted = true;
+        } else {
+            request();
+        }
+
+        if (count > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AptosPageIterator::next(JsonVariantConst& item) {
+    if (source == APTOS_PAGES_NONE) {
+        return false;
+    }
+    if (pageCount == 0 || position == stop) {
+        if (!advance()) {
+            return false;
+        }
+    }
+    item = *position;
+    ++position;
+    itemCount++;
+    return true;
+}
+
+void AptosPageIterator::end() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    requested = false;
+    source = APTOS_PAGES_NONE;
+    exhausted = true;
+    current = 0;
+    position = JsonArrayConst::iterator();
+    stop = JsonArrayConst::iterator();
+    for (int i = 0; i < 2; i++) {
+        pages[i].items.clear();
+        pages[i].cursor = "";
+        pages[i].ok = false;
+    }
+}
+
+bool AptosPageIterator::failed() const {
+    return error;
+}
+
+uint32_t AptosPageIterator::pagesRead() const {
+    return pageCount;
+}
+
+uint32_t AptosPageIterator::itemsRead() const {
+    return itemCount;
+}
+
+String AptosPageIterator::getLastError() const {
+    return lastError;
+}
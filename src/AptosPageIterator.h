@@ -0,0 +1,122 @@
+#ifndef APTOS_PAGE_ITERATOR_H
+#define APTOS_PAGE_ITERATOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "AptosSDK.h"
+
+// Items requested per page; the node caps transaction and event pages at 100
+#define APTOS_PAGE_DEFAULT_SIZE 25
+#define APTOS_PAGE_MAX_SIZE 100
+
+// Stack of the task that fetches the next page (ESP32)
+#ifndef APTOS_PAGE_STACK_SIZE
+#define APTOS_PAGE_STACK_SIZE 8192
+#endif
+
+enum AptosPageSource {
+    APTOS_PAGES_NONE,
+    APTOS_PAGES_TRANSACTIONS,           // Ledger transactions from a version on
+    APTOS_PAGES_ACCOUNT_TRANSACTIONS,   // Sent by an account, from a sequence number on
+    APTOS_PAGES_ACCOUNT_RESOURCES,
+    APTOS_PAGES_ACCOUNT_MODULES,
+    APTOS_PAGES_EVENTS_BY_HANDLE,
+    APTOS_PAGES_EVENTS_BY_CREATION_NUMBER
+};
+
+// Walks a paginated listing one element at a time.
+//
+// At most two pages are held: the one being read and the next, which is
+// fetched on a separate task (a FreeRTOS task on ESP32) while the caller
+// works through the current one. Memory therefore depends on the page size
+// and the filter, not on the length of the listing.
+//
+// The next page starts where the node's X-Aptos-Cursor header says
+// (resources and modules). Listings without a cursor (transactions and
+// events) advance by the number of items read, and end with the first
+// short page.
+//
+//   AptosPageIterator pages(aptos);
+//   pages.accountTransactions(address);
+//   JsonVariantConst txn;
+//   while (pages.next(txn)) { ... }
+//   if (pages.failed()) { Serial.println(pages.getLastError()); }
+//
+// An item stays valid until the following call to next(). One task drives
+// an iterator; the AptosSDK underneath may be shared.
+class AptosPageIterator {
+private:
+    struct Page {
+        JsonDocument items;
+        String cursor;      // X-Aptos-Cursor of the answer
+        bool ok;
+    };
+
+    AptosSDK& sdk;
+    AptosPageSource source;
+    String address;
+    String key;             // Event handle, or the creation number
+    uint64_t ledgerVersion;
+    size_t pageSize;
+    bool prefetch;
+    const JsonDocument* filter;
+
+    Page pages[2];
+    int current;            // Index of the page being read
+    JsonArrayConst::iterator position;  // Next item in it
+    JsonArrayConst::iterator stop;
+    String nextStart;       // Start of the page after the current one
+    uint64_t nextNumber;    // Same, for listings without a cursor
+    String pending;         // Endpoint of the page after the current one
+    bool requested;         // ... which is being (or, without prefetch, to be) fetched
+    bool exhausted;         // No page after the current one
+    bool error;
+    uint32_t pageCount;
+    uint32_t itemCount;
+    std::thread worker;
+    String lastError;
+
+    void reset(AptosPageSource source, const String& address, const String& key,
+               uint64_t start, uint64_t ledgerVersion);
+    String endpoint() const;
+    void request();
+    void wait();
+    bool advance();
+
+public:
+    AptosPageIterator(AptosSDK& sdk, size_t pageSize = APTOS_PAGE_DEFAULT_SIZE);
+    ~AptosPageIterator();
+
+    // Sources; each starts a new walk
+    void transactions(uint64_t startVersion = 0);
+    void accountTransactions(const String& address, uint64_t startSequenceNumber = 0);
+    void accountResources(const String& address, uint64_t ledgerVersion = 0);
+    void accountModules(const String& address, uint64_t ledgerVersion = 0);
+    // eventHandle is "<struct type>/<field name>", e.g.
+    // "0x1::coin::CoinStore<0x1::aptos_coin::AptosCoin>/deposit_events"
+    void eventsByHandle(const String& address, const String& eventHandle, uint64_t startSequenceNumber = 0);
+    void eventsByCreationNumber(const String& address, uint64_t creationNumber,
+                                uint64_t startSequenceNumber = 0);
+
+    // Configuration, taking effect with the next source
+    void setPageSize(size_t pageSize);
+    // Fetch the next page while the current one is read (default on)
+    void setPrefetch(bool enabled);
+    // Applied to each page, so it describes an array, e.g.
+    // responseFilter(APTOS_FILTER_TRANSACTION_LIST); must outlive the walk
+    void setFilter(const JsonDocument* filter);
+
+    // Next element; false at the end of the listing or on error
+    bool next(JsonVariantConst& item);
+
+    // Stops the walk, waiting for a page still being fetched
+    void end();
+
+    // Status
+    bool failed() const;
+    uint32_t pagesRead() const;
+    uint32_t itemsRead() const;
+    String getLastError() const;
+};
+
+#endif
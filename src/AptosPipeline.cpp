@@ -0,0 +1,341 @@
+#include "AptosPipeline.h"
+
+// Committed transactions fetched per poll; the node caps pages at 100
+#define APTOS_PIPELINE_PAGE_LIMIT 100
+
+AptosPipeline::AptosPipeline(AptosSDK& sdk, AptosAccount& sender, size_t window)
+    : sdk(sdk), sender(sender), window(1), inFlightCount(0), nextId(1),
+      pollIntervalMs(APTOS_PIPELINE_DEFAULT_POLL_MS), resubmitMs(APTOS_PIPELINE_DEFAULT_RESUBMIT_MS),
+      expirationSecs(APTOS_PIPELINE_DEFAULT_EXPIRATION_SECS), submitTimeoutMs(60000), lastPollMs(0),
+      callback(nullptr), callbackContext(nullptr), committedCount(0), failedCount(0) {
+    address = sender.getAccountAddress();
+    for (size_t i = 0; i < APTOS_PIPELINE_MAX_WINDOW; i++) {
+        slots[i].used = false;
+        slots[i].posted = false;
+    }
+    setWindow(window);
+}
+
+void AptosPipeline::setWindow(size_t window) {
+    if (window < 1) {
+        window = 1;
+    }
+    this->window = window > APTOS_PIPELINE_MAX_WINDOW ? APTOS_PIPELINE_MAX_WINDOW : window;
+}
+
+void AptosPipeline::setCallback(AptosPipelineCallback callback, void* context) {
+    this->callback = callback;
+    callbackContext = context;
+}
+
+void AptosPipeline::setPollInterval(uint32_t ms) {
+    pollIntervalMs = ms;
+}
+
+void AptosPipeline::setResubmitInterval(uint32_t ms) {
+    resubmitMs = ms;
+}
+
+void AptosPipeline::setExpiration(uint32_t seconds) {
+    expirationSecs = seconds;
+}
+
+void AptosPipeline::setSubmitTimeout(uint32_t ms) {
+    submitTimeoutMs = ms;
+}
+
+AptosPipeline::Slot* AptosPipeline::freeSlot() {
+    for (size_t i = 0; i < APTOS_PIPELINE_MAX_WINDOW; i++) {
+        if (!slots[i].used) {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+AptosPipeline::Slot* AptosPipeline::findSlot(uint64_t sequenceNumber) {
+    for (size_t i = 0; i < APTOS_PIPELINE_MAX_WINDOW; i++) {
+        if (slots[i].used && slots[i].sequenceNumber == sequenceNumber) {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+bool AptosPipeline::allocate(uint64_t& sequenceNumber) {
+    // After a rewind the allocator hands out numbers that later transactions
+    // still hold; those are skipped
+    for (size_t attempt = 0; attempt <= APTOS_PIPELINE_MAX_WINDOW; attempt++) {
+        if (!sdk.sequenceNumbers.allocate(address, sequenceNumber)) {
+            uint64_t onChain;
+            if (!sdk.fetchSequenceNumber(address, onChain)) {
+                lastError = "Failed to get sequence number";
+                return false;
+            }
+            sequenceNumber = sdk.sequenceNumbers.seedAndAllocate(address, onChain);
+        }
+        if (findSlot(sequenceNumber) == nullptr) {
+            return true;
+        }
+    }
+    lastError = "No free sequence number";
+    return false;
+}
+
+bool AptosPipeline::signInto(Slot& slot, AptosTransaction& txn, uint64_t sequenceNumber) {
+    txn.setSequenceNumber(sequenceNumber);
+    if (!sender.signTransaction(txn, slot.signedTxn)) {
+        lastError = "Failed to sign transaction: " + txn.getError();
+        return false;
+    }
+    slot.sequenceNumber = sequenceNumber;
+    slot.hash = AptosUtils::generateTransactionHash(slot.signedTxn.data(), slot.signedTxn.size());
+    return true;
+}
+
+bool AptosPipeline::post(Slot& slot, JsonDocument& response, int& httpCode) {
+    response.clear();
+    slot.lastPostMs = millis();
+    // The SDK may be shared, so its lastHttpCode could be another task's
+    httpCode = 0;
+    return sdk.postTransactionBCS(slot.signedTxn.data(), slot.signedTxn.size(), response, &httpCode);
+}
+
+bool AptosPipeline::submit(AptosTransaction& txn, uint32_t* id) {
+    if (!txn.hasBCSPayload()) {
+        lastError = "Pipelined transactions need a BCS payload";
+        return false;
+    }
+
+    // Wait for room in the window
+    unsigned long waitStart = millis();
+    while (inFlightCount >= window) {
+        poll();
+        if (inFlightCount < window) {
+            break;
+        }
+        if (millis() - waitStart >= submitTimeoutMs) {
+            lastError = "Pipeline window full";
+            return false;
+        }
+        delay(10);
+    }
+
+    uint8_t chainId;
+    if (!sdk.cachedChainId(chainId)) {
+        lastError = "Failed to get chain ID";
+        return false;
+    }
+
+    Slot& slot = *freeSlot();
+    uint64_t sequenceNumber;
+    if (!allocate(sequenceNumber)) {
+        return false;
+    }
+
+    txn.setSender(sender.getAddress())
+       .setExpirationTimestamp(sdk.getChainTimestamp() + expirationSecs)
+       .setChainId(chainId);
+    if (txn.getGasUnitPrice() == 0) {
+        txn.setGasUnitPrice(sdk.gasUnitPrice());
+    }
+
+    for (int attempt = 0; ; attempt++) {
+        if (!signInto(slot, txn, sequenceNumber)) {
+            sdk.sequenceNumbers.release(address, sequenceNumber);
+            return false;
+        }
+
+        JsonDocument response;
+        int httpCode;
+        bool answered = post(slot, response, httpCode);
+        bool transient = answered && httpCode >= 500;
+        if (!answered || transient || response["error_code"].isNull()) {
+            // Accepted, or the answer was lost on the way back, or the node
+            // was busy. Either way it is tracked; poll() posts
+            // unacknowledged transactions again.
+            slot.used = true;
+            slot.posted = answered && !transient;
+            slot.id = nextId++;
+            slot.expiration = txn.getExpirationTimestamp();
+            inFlightCount++;
+            if (id != nullptr) {
+                *id = slot.id;
+            }
+            return true;
+        }
+
+        lastError = AptosUtils::getJsonString(response, "message", "Transaction rejected");
+        int sequenceError = AptosSDK::sequenceNumberError(response);
+        if (sequenceError == 0) {
+            // Never reached mempool: the next submit() reuses the number
+            sdk.sequenceNumbers.release(address, sequenceNumber);
+            return false;
+        }
+
+        uint64_t onChain;
+        if (attempt >= APTOS_SEQUENCE_MAX_RESYNCS || !sdk.fetchSequenceNumber(address, onChain)) {
+            sdk.sequenceNumbers.invalidate(address);
+            return false;
+        }
+
+        // Same policy as AptosSDK::signAndSubmit, then skip our own numbers
+        if (sequenceError == APTOS_VM_SEQUENCE_NUMBER_TOO_OLD) {
+            uint64_t minimum = sequenceNumber + 1;
+            sequenceNumber = sdk.sequenceNumbers.advanceAndAllocate(address, onChain > minimum ? onChain : minimum);
+        } else {
+            sdk.sequenceNumbers.invalidate(address);
+            sequenceNumber = sdk.sequenceNumbers.seedAndAllocate(address, onChain);
+        }
+        if (findSlot(sequenceNumber) != nullptr && !allocate(sequenceNumber)) {
+            return false;
+        }
+    }
+}
+
+void AptosPipeline::finish(Slot& slot, AptosPipelineStatus status, uint64_t version, const String& vmStatus) {
+    AptosPipelineResult result;
+    result.id = slot.id;
+    result.sequenceNumber = slot.sequenceNumber;
+    result.hash = slot.hash;
+    result.status = status;
+    result.version = version;
+    result.vmStatus = vmStatus;
+
+    // The signed bytes keep their buffer for the next transaction
+    slot.used = false;
+    slot.posted = false;
+    slot.signedTxn.clear();
+    inFlightCount--;
+
+    if (status == APTOS_PIPELINE_COMMITTED) {
+        committedCount++;
+    } else {
+        failedCount++;
+    }
+    if (callback != nullptr) {
+        callback(result, callbackContext);
+    }
+}
+
+bool AptosPipeline::checkCommitted(int& completed) {
+    uint64_t lowest = UINT64_MAX;
+    uint64_t highest = 0;
+    for (size_t i = 0; i < APTOS_PIPELINE_MAX_WINDOW; i++) {
+        if (slots[i].used) {
+            lowest = slots[i].sequenceNumber < lowest ? slots[i].sequenceNumber : lowest;
+            highest = slots[i].sequenceNumber > highest ? slots[i].sequenceNumber : highest;
+        }
+    }
+    uint64_t span = highest - lowest + 1;
+    int limit = span > APTOS_PIPELINE_PAGE_LIMIT ? APTOS_PIPELINE_PAGE_LIMIT : (int)span;
+
+    // Committed transactions of the sender, addressed by sequence number: one
+    // request covers the whole window
+    JsonDocument response;
+    if (!sdk.getAccountTransactions(address, response, limit, (int)lowest,
+                                    AptosSDK::responseFilter(APTOS_FILTER_TRANSACTION_LIST)) ||
+        !response.is<JsonArray>()) {
+        lastError = "Failed to get account transactions";
+        return false;
+    }
+
+    for (JsonVariant item : response.as<JsonArray>()) {
+        Slot* slot = findSlot(AptosUtils::jsonUint64(item["sequence_number"]));
+        if (slot == nullptr) {
+            continue;
+        }
+        String hash = item["hash"].as<String>();
+        if (!hash.equalsIgnoreCase(slot->hash)) {
+            // Someone else (another device with the same key) used the number
+            finish(*slot, APTOS_PIPELINE_REJECTED, 0, "Sequence number used by " + hash);
+        } else if (item["success"].as<bool>()) {
+            finish(*slot, APTOS_PIPELINE_COMMITTED, AptosUtils::jsonUint64(item["version"]), item["vm_status"].as<String>());
+        } else {
+            finish(*slot, APTOS_PIPELINE_FAILED, AptosUtils::jsonUint64(item["version"]), item["vm_status"].as<String>());
+        }
+        completed++;
+    }
+    return true;
+}
+
+void AptosPipeline::checkExpired(int& completed) {
+    // Expiration is judged by the ledger clock, as the node does
+    uint64_t now = sdk.getChainTimestamp();
+    for (size_t i = 0; i < APTOS_PIPELINE_MAX_WINDOW; i++) {
+        Slot& slot = slots[i];
+        if (!slot.used || now <= slot.expiration + APTOS_PIPELINE_EXPIRY_GRACE_SECS) {
+            continue;
+        }
+        // Later transactions wait on this number; hand it out again so the
+        // next submit() fills the gap
+        sdk.sequenceNumbers.rewind(address, slot.sequenceNumber);
+        finish(slot, APTOS_PIPELINE_EXPIRED, 0, "Transaction expired");
+        completed++;
+    }
+}
+
+void AptosPipeline::resubmitStale() {
+    unsigned long now = millis();
+    for (size_t i = 0; i < APTOS_PIPELINE_MAX_WINDOW; i++) {
+        Slot& slot = slots[i];
+        if (!slot.used || (slot.posted && now - slot.lastPostMs < resubmitMs)) {
+            continue;
+        }
+        // Identical bytes, so the node treats it as the same transaction.
+        // Any answer counts as acknowledged: a rejection such as
+        // SEQUENCE_NUMBER_TOO_OLD is resolved by the commit check.
+        JsonDocument response;
+        int httpCode;
+        if (post(slot, response, httpCode) && httpCode < 500) {
+            slot.posted = true;
+        }
+    }
+}
+
+int AptosPipeline::poll() {
+    if (inFlightCount == 0) {
+        return 0;
+    }
+    if (lastPollMs != 0 && millis() - lastPollMs < pollIntervalMs) {
+        return 0;
+    }
+    lastPollMs = millis();
+
+    int completed = 0;
+    if (checkCommitted(completed)) {
+        // Only once the node has confirmed what is committed
+        checkExpired(completed);
+    }
+    resubmitStale();
+    return completed;
+}
+
+bool AptosPipeline::flush(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (inFlightCount > 0) {
+        if (millis() - start >= timeoutMs) {
+            lastError = "Timed out with " + String((unsigned long)inFlightCount) + " in flight";
+            return false;
+        }
+        poll();
+        delay(10);
+    }
+    return true;
+}
+
+size_t AptosPipeline::inFlight() const {
+    return inFlightCount;
+}
+
+uint32_t AptosPipeline::committed() const {
+    return committedCount;
+}
+
+uint32_t AptosPipeline::failed() const {
+    return failedCount;
+}
+
+String AptosPipeline::getLastError() const {
+    return lastError;
+}
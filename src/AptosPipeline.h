@@ -0,0 +1,134 @@
+#ifndef APTOS_PIPELINE_H
+#define APTOS_PIPELINE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "AptosSDK.h"
+
+// Upper bound for the in-flight window; the slots are allocated up front
+#ifndef APTOS_PIPELINE_MAX_WINDOW
+#define APTOS_PIPELINE_MAX_WINDOW 16
+#endif
+
+// Defaults, all adjustable at run time
+#define APTOS_PIPELINE_DEFAULT_WINDOW 8
+#define APTOS_PIPELINE_DEFAULT_POLL_MS 250
+#define APTOS_PIPELINE_DEFAULT_RESUBMIT_MS 5000
+#define APTOS_PIPELINE_DEFAULT_EXPIRATION_SECS 30
+
+// Local clock slack before an uncommitted transaction counts as expired
+#define APTOS_PIPELINE_EXPIRY_GRACE_SECS 5
+
+enum AptosPipelineStatus {
+    APTOS_PIPELINE_COMMITTED,   // Executed successfully
+    APTOS_PIPELINE_FAILED,      // Committed, but the VM aborted it (see vmStatus)
+    APTOS_PIPELINE_REJECTED,    // Refused by the node or its number was used elsewhere
+    APTOS_PIPELINE_EXPIRED      // Never committed before its expiration
+};
+
+struct AptosPipelineResult {
+    uint32_t id;                // As returned by submit()
+    uint64_t sequenceNumber;
+    String hash;
+    AptosPipelineStatus status;
+    uint64_t version;           // Ledger version, 0 unless committed
+    String vmStatus;            // vm_status, or the node's error message
+};
+
+typedef void (*AptosPipelineCallback)(const AptosPipelineResult& result, void* context);
+
+// Keeps up to `window` transactions of one sender in flight at once.
+//
+// submit() assigns the next sequence number (from the SDK's allocator, so
+// plain transferCoin() calls on the same AptosSDK stay consistent), signs
+// the transaction as BCS and posts it without waiting for the previous one
+// to commit. poll() tracks everything in flight with one request (the
+// sender's committed transactions from the oldest pending number on) and
+// reports each outcome through the callback.
+//
+// Failures are handled per transaction:
+// - a rejected submission gives its number back, so the next submit()
+//   reuses it and no gap is left behind the in-flight ones;
+// - a sequence number rejection re-syncs from the node and re-signs;
+// - a post whose answer was lost, or that sits uncommitted for longer than
+//   the resubmit interval, is posted again (same bytes, same hash);
+// - a transaction that expired uncommitted rewinds the allocator to its
+//   number, so the next submit() fills the gap and unblocks later ones.
+//
+// Pipelined transactions get a short expiration (30 s by default) so that
+// a lost transaction is detected quickly. One task drives a pipeline; the
+// AptosSDK underneath may be shared.
+class AptosPipeline {
+private:
+    struct Slot {
+        bool used;
+        bool posted;            // Node acknowledged the post
+        uint32_t id;
+        uint64_t sequenceNumber;
+        uint64_t expiration;
+        unsigned long lastPostMs;
+        String hash;
+        AptosBCSWriter signedTxn;
+    };
+
+    AptosSDK& sdk;
+    AptosAccount& sender;
+    AccountAddress address;
+    Slot slots[APTOS_PIPELINE_MAX_WINDOW];
+    size_t window;
+    size_t inFlightCount;
+    uint32_t nextId;
+    uint32_t pollIntervalMs;
+    uint32_t resubmitMs;
+    uint32_t expirationSecs;
+    uint32_t submitTimeoutMs;
+    unsigned long lastPollMs;
+    AptosPipelineCallback callback;
+    void* callbackContext;
+    uint32_t committedCount;
+    uint32_t failedCount;
+    String lastError;
+
+    Slot* freeSlot();
+    Slot* findSlot(uint64_t sequenceNumber);
+    bool allocate(uint64_t& sequenceNumber);
+    bool signInto(Slot& slot, AptosTransaction& txn, uint64_t sequenceNumber);
+    bool post(Slot& slot, JsonDocument& response, int& httpCode);
+    void finish(Slot& slot, AptosPipelineStatus status, uint64_t version, const String& vmStatus);
+    bool checkCommitted(int& completed);
+    void checkExpired(int& completed);
+    void resubmitStale();
+
+public:
+    AptosPipeline(AptosSDK& sdk, AptosAccount& sender, size_t window = APTOS_PIPELINE_DEFAULT_WINDOW);
+
+    // Configuration
+    void setWindow(size_t window);
+    void setCallback(AptosPipelineCallback callback, void* context = nullptr);
+    void setPollInterval(uint32_t ms);
+    void setResubmitInterval(uint32_t ms);
+    void setExpiration(uint32_t seconds);
+    void setSubmitTimeout(uint32_t ms);
+
+    // Fills in sender, sequence number, expiration, chain id and (unless
+    // set) the gas unit price, signs and posts txn (which needs a BCS
+    // payload). Polls while the window is full,
+    // for at most the submit timeout. False if it could not be sent or the
+    // node refused it (see getLastError()); nothing is reported for it.
+    bool submit(AptosTransaction& txn, uint32_t* id = nullptr);
+
+    // Checks in-flight transactions, at most once per poll interval; call it
+    // from loop(). Returns the number of transactions that finished.
+    int poll();
+
+    // Polls until nothing is in flight; false on timeout
+    bool flush(uint32_t timeoutMs = 60000);
+
+    // Status
+    size_t inFlight() const;
+    uint32_t committed() const;
+    uint32_t failed() const;
+    String getLastError() const;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "AptosResponseCache.h"
+
+AptosResponseCache::AptosResponseCache()
+    : maxEntries(0), maxBytes(APTOS_CACHE_DEFAULT_MAX_BYTES), ttlMs(APTOS_CACHE_DEFAULT_TTL_MS), bytes(0),
+      useCounter(0), hits(0), misses(0), evictions(0) {
+    for (size_t i = 0; i < APTOS_CACHE_MAX_ENTRIES; i++) {
+        entries[i].used = false;
+    }
+}
+
+void AptosResponseCache::configure(size_t maxEntries, size_t maxBytes) {
+    std::lock_guard<std::mutex> guard(lock);
+    this->maxEntries = maxEntries > APTOS_CACHE_MAX_ENTRIES ? APTOS_CACHE_MAX_ENTRIES : maxEntries;
+    this->maxBytes = maxBytes;
+    for (size_t i = 0; i < APTOS_CACHE_MAX_ENTRIES; i++) {
+        drop(entries[i]);
+    }
+}
+
+void AptosResponseCache::setTtl(uint32_t ms) {
+    std::lock_guard<std::mutex> guard(lock);
+    ttlMs = ms;
+}
+
+bool AptosResponseCache::enabled() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return maxEntries > 0;
+}
+
+void AptosResponseCache::drop(Entry& entry) {
+    if (!entry.used) {
+        return;
+    }
+    bytes -= entry.body.length();
+    entry.used = false;
+    // Give the memory back; cached bodies can be large
+    entry.key = String();
+    entry.body = String();
+}
+
+AptosResponseCache::Entry* AptosResponseCache::freeSlot() {
+    for (size_t i = 0; i < maxEntries; i++) {
+        if (!entries[i].used) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+AptosResponseCache::Entry* AptosResponseCache::leastRecentlyUsed() {
+    Entry* oldest = nullptr;
+    for (size_t i = 0; i < maxEntries; i++) {
+        if (entries[i].used && (oldest == nullptr || entries[i].lastUsed < oldest->lastUsed)) {
+            oldest = &entries[i];
+        }
+    }
+    return oldest;
+}
+
+bool AptosResponseCache::get(const String& key, JsonDocument& response) {
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < maxEntries; i++) {
+        Entry& entry = entries[i];
+        if (!entry.used || entry.key != key) {
+            continue;
+        }
+        if (!entry.pinned && millis() - entry.storedAt >= ttlMs) {
+            drop(entry);
+            break;
+        }
+        if (deserializeJson(response, entry.body)) {
+            drop(entry);
+            break;
+        }
+        entry.lastUsed = ++useCounter;
+        hits++;
+        return true;
+    }
+    misses++;
+    return false;
+}
+
+void AptosResponseCache::put(const String& key, const JsonDocument& response, bool pinned) {
+    String body;
+    serializeJson(response, body);
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (maxEntries == 0 || body.length() > maxBytes) {
+        return;
+    }
+
+    // Replace an older copy, then evict until the new body fits
+    for (size_t i = 0; i < maxEntries; i++) {
+        if (entries[i].used && entries[i].key == key) {
+            drop(entries[i]);
+        }
+    }
+    // body fits in an empty cache, so this stops before running out of entries
+    while (bytes + body.length() > maxBytes) {
+        drop(*leastRecentlyUsed());
+        evictions++;
+    }
+    Entry* slot = freeSlot();
+    if (slot == nullptr) {
+        slot = leastRecentlyUsed();
+        drop(*slot);
+        evictions++;
+    }
+
+    slot->key = key;
+    slot->body = body;
+    slot->storedAt = millis();
+    slot->lastUsed = ++useCounter;
+    slot->pinned = pinned;
+    slot->used = true;
+    bytes += body.length();
+}
+
+void AptosResponseCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < APTOS_CACHE_MAX_ENTRIES; i++) {
+        drop(entries[i]);
+    }
+}
+
+AptosCacheStats AptosResponseCache::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    AptosCacheStats result;
+    result.hits = hits;
+    result.misses = misses;
+    result.evictions = evictions;
+    result.entries = 0;
+    for (size_t i = 0; i < maxEntries; i++) {
+        result.entries += entries[i].used ? 1 : 0;
+    }
+    result.bytes = bytes;
+    return result;
+}
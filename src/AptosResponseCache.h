@@ -0,0 +1,76 @@
+#ifndef APTOS_RESPONSE_CACHE_H
+#define APTOS_RESPONSE_CACHE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <mutex>
+
+// Upper bound for the number of cached responses
+#ifndef APTOS_CACHE_MAX_ENTRIES
+#define APTOS_CACHE_MAX_ENTRIES 16
+#endif
+
+// Defaults used by AptosSDK::setCacheSize() / setCacheTtl()
+#define APTOS_CACHE_DEFAULT_MAX_BYTES 8192
+#define APTOS_CACHE_DEFAULT_TTL_MS 2000
+
+struct AptosCacheStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    size_t entries;
+    size_t bytes;       // Serialized size of all cached responses
+};
+
+// Bounded LRU cache of parsed read responses, stored as compact JSON.
+//
+// An entry read at a pinned ledger version can never change and stays
+// until it is evicted; an entry for the latest version expires after the
+// TTL. The cache is limited both in entries and in bytes, and evicts the
+// least recently used entry to make room. Disabled (0 entries) until
+// configure() is called. All methods are safe to call from several tasks.
+class AptosResponseCache {
+private:
+    struct Entry {
+        String key;
+        String body;
+        unsigned long storedAt;
+        uint32_t lastUsed;
+        bool pinned;
+        bool used;
+    };
+
+    Entry entries[APTOS_CACHE_MAX_ENTRIES];
+    size_t maxEntries;
+    size_t maxBytes;
+    uint32_t ttlMs;
+    size_t bytes;
+    uint32_t useCounter;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    mutable std::mutex lock;
+
+    void drop(Entry& entry);
+    Entry* freeSlot();
+    Entry* leastRecentlyUsed();
+
+public:
+    AptosResponseCache();
+
+    // maxEntries is capped at APTOS_CACHE_MAX_ENTRIES; 0 disables the cache
+    void configure(size_t maxEntries, size_t maxBytes);
+    void setTtl(uint32_t ms);
+    bool enabled() const;
+
+    // Fills response from a live entry; counts a hit or a miss
+    bool get(const String& key, JsonDocument& response);
+
+    // Stores response; pinned entries do not expire
+    void put(const String& key, const JsonDocument& response, bool pinned);
+
+    void clear();
+    AptosCacheStats stats() const;
+};
+
+#endif
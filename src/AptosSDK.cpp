@@ -1,24 +1,65 @@
 #include "AptosSDK.h"
+#include <condition_variable>
+#include <memory>
+#include <vector>
+#ifdef ESP32
+#include <esp_pthread.h>
+#endif
 
-AptosSDK::AptosSDK(const String& url) : nodeUrl(url), timeout(10000), debugMode(false) {
-    // Initialize HTTP client
-    http.setTimeout(timeout);
-    http.setReuse(true);
+AptosSDK::AptosSDK(const String& url)
+    : nodes(url), timeout(10000), debugMode(false), submitMode(APTOS_SUBMIT_JSON),
+      maxResponseSize(APTOS_DEFAULT_MAX_RESPONSE_SIZE), lastHttpCode(0),
+      waitByHashAvailable(true), localSequenceNumbers(true), chainMetadata(),
+      gasPriceTtlMs(APTOS_GAS_PRICE_TTL_MS), hedging(false),
+      hedgePercentile(APTOS_HEDGE_DEFAULT_PERCENTILE), hedgeRequests(0), hedgesFired(0), hedgesWon(0),
+      coalescing(true), writeGeneration(0), coalesceRequests(0), coalescedReads(0) {
+    // Initialize HTTP clients
+    for (size_t i = 0; i < APTOS_HTTP_CHANNELS; i++) {
+        channels[i].client.setTimeout(timeout);
+        channels[i].client.setReuse(true);
+        channels[i].node = -1;
+        channels[i].busy = false;
+    }
 }
 
 AptosSDK::~AptosSDK() {
-    http.end();
+    for (size_t i = 0; i < APTOS_HTTP_CHANNELS; i++) {
+        // A hedge that lost may still be waiting for its node
+        if (channels[i].worker.joinable()) {
+            channels[i].worker.join();
+        }
+        channels[i].client.end();
+    }
 }
 
 void AptosSDK::setNodeUrl(const String& url) {
-    nodeUrl = url;
+    {
+        std::lock_guard<std::mutex> guard(httpMutex);
+        // The new node takes index 0, so connections kept alive to the old
+        // one must not look like they belong to it; exchange() closes them.
+        // A hedge still running would set its channel's node again.
+        for (size_t i = 0; i < APTOS_HTTP_CHANNELS; i++) {
+            if (channels[i].worker.joinable()) {
+                channels[i].worker.join();
+            }
+            channels[i].node = -1;
+        }
+        nodes.reset(url);
+    }
+    {
+        std::lock_guard<std::mutex> guard(metadataMutex);
+        chainMetadata = AptosChainMetadata();
+    }
+    waitByHashAvailable = true;
+    sequenceNumbers.clear();
+    responseCache.clear();
     logDebug("Node URL set to: " + url);
 }
 
 void AptosSDK::setTimeout(int timeoutMs) {
+    // Not set on the clients here: a losing hedge may still be using one
     timeout = timeoutMs;
-    http.setTimeout(timeout);
-    logDebug("Timeout set to: " + String(timeout) + "ms");
+    logDebug("Timeout set to: " + String(timeoutMs) + "ms");
 }
 
 void AptosSDK::setDebugMode(bool enabled) {
@@ -26,11 +67,120 @@ void AptosSDK::setDebugMode(bool enabled) {
     logDebug("Debug mode: " + String(enabled ? "enabled" : "disabled"));
 }
 
-String AptosSDK::formatUrl(const String& endpoint) {
+void AptosSDK::setSubmitMode(AptosSubmitMode mode) {
+    submitMode = mode;
+    logDebug("Submit mode: " + String(mode == APTOS_SUBMIT_BCS ? "BCS" : "JSON"));
+}
+
+void AptosSDK::setMaxResponseSize(size_t maxBytes) {
+    maxResponseSize = maxBytes;
+    logDebug("Max response size: " + String((unsigned long)maxBytes));
+}
+
+void AptosSDK::setLocalSequenceNumbers(bool enabled) {
+    localSequenceNumbers = enabled;
+    sequenceNumbers.clear();
+    logDebug("Local sequence numbers: " + String(enabled ? "enabled" : "disabled"));
+}
+
+void AptosSDK::resetSequenceNumbers(const String& address) {
+    AccountAddress parsed;
+    if (address.isEmpty()) {
+        sequenceNumbers.clear();
+    } else if (parseAddress(address, parsed)) {
+        resetSequenceNumbers(parsed);
+    }
+}
+
+void AptosSDK::resetSequenceNumbers(const AccountAddress& address) {
+    sequenceNumbers.invalidate(address);
+}
+
+void AptosSDK::setCacheSize(size_t maxEntries, size_t maxBytes) {
+    responseCache.configure(maxEntries, maxBytes);
+    logDebug("Cache size: " + String((unsigned long)maxEntries) + " entries, " +
+             String((unsigned long)maxBytes) + " bytes");
+}
+
+void AptosSDK::setCacheTtl(uint32_t ttlMs) {
+    responseCache.setTtl(ttlMs);
+}
+
+void AptosSDK::clearCache() {
+    responseCache.clear();
+}
+
+AptosCacheStats AptosSDK::getCacheStats() const {
+    return responseCache.stats();
+}
+
+bool AptosSDK::addNode(const String& url) {
+    if (!nodes.add(url)) {
+        logDebug("Node not added: " + url);
+        return false;
+    }
+    logDebug("Node added: " + url);
+    return true;
+}
+
+size_t AptosSDK::getNodeCount() const {
+    return nodes.size();
+}
+
+bool AptosSDK::getNodeStats(size_t index, AptosNodeStats& stats) const {
+    return nodes.stats(index, stats);
+}
+
+void AptosSDK::setHedging(bool enabled, uint8_t percentile) {
+    std::lock_guard<std::mutex> guard(httpMutex);
+    hedging = enabled;
+    hedgePercentile = percentile > 100 ? 100 : percentile;
+    logDebug("Hedged reads: " + String(enabled ? "enabled" : "disabled"));
+}
+
+AptosHedgeStats AptosSDK::getHedgeStats() const {
+    AptosHedgeStats stats;
+    stats.requests = hedgeRequests;
+    stats.fired = hedgesFired;
+    stats.won = hedgesWon;
+    return stats;
+}
+
+void AptosSDK::setCoalescing(bool enabled) {
+    std::lock_guard<std::mutex> guard(sharedMutex);
+    coalescing = enabled;
+    logDebug("Read coalescing: " + String(enabled ? "enabled" : "disabled"));
+}
+
+AptosCoalesceStats AptosSDK::getCoalesceStats() const {
+    AptosCoalesceStats stats;
+    stats.requests = coalesceRequests;
+    stats.coalesced = coalescedReads;
+    return stats;
+}
+
+String AptosSDK::formatUrl(int node, const String& endpoint) {
+    String base = nodes.url(node);
     if (endpoint.startsWith("/")) {
-        return nodeUrl + endpoint;
+        return base + endpoint;
     }
-    return nodeUrl + "/" + endpoint;
+    return base + "/" + endpoint;
+}
+
+bool AptosSDK::parseAddress(const String& address, AccountAddress& parsed) {
+    if (!parsed.parse(address)) {
+        logDebug("Invalid address: " + address);
+        return false;
+    }
+    return true;
+}
+
+String AptosSDK::accountEndpoint(const AccountAddress& address) {
+    // "accounts/0x" + 64 digits, built in place
+    char endpoint[9 + ACCOUNT_ADDRESS_HEX_SIZE];
+    memcpy(endpoint, "accounts/", 9);
+    address.format(endpoint + 9);
+    return String(endpoint);
 }
 
 void AptosSDK::logDebug(const String& message) {
@@ -40,118 +190,606 @@ void AptosSDK::logDebug(const String& message) {
 }
 
 bool AptosSDK::makeHttpRequest(const String& endpoint, JsonDocument& response, 
-                              const String& method, const String& payload) {
-    String url = formatUrl(endpoint);
-    logDebug("Making " + method + " request to: " + url);
+                              const String& method, const String& payload, const JsonDocument* filter,
+                              int* status) {
+    return makeHttpRequest(endpoint, response, method, (const uint8_t*)payload.c_str(),
+                           payload.length(), APTOS_CONTENT_TYPE_JSON, filter, status);
+}
+
+bool AptosSDK::makeHttpRequest(const String& endpoint, JsonDocument& response, const String& method,
+                              const uint8_t* body, size_t bodyLength, const char* contentType,
+                              const JsonDocument* filter, int* status) {
+    return sendHttpRequest(endpoint, response, method, body, nullptr, bodyLength, contentType, filter,
+                           nullptr, status);
+}
+
+bool AptosSDK::makeHttpRequest(const String& endpoint, JsonDocument& response, Stream& body,
+                              size_t bodyLength, const char* contentType, const JsonDocument* filter,
+                              int* status) {
+    return sendHttpRequest(endpoint, response, "POST", nullptr, &body, bodyLength, contentType, filter,
+                           nullptr, status);
+}
+
+// Submissions, and the reads that have to agree with them (the account's
+// sequence number, transaction lookups), go to one node
+static bool submissionEndpoint(const String& endpoint) {
+    if (endpoint.startsWith("transactions")) {
+        return true;
+    }
+    return endpoint.startsWith("accounts/") && endpoint.indexOf('/', 9) < 0;
+}
+
+// A read in flight that identical reads from other tasks wait on
+struct AptosSDK::SharedRead {
+    String key;
+    uint32_t generation;    // writeGeneration when it was sent
+    size_t waiters;
+    bool done;
+    bool parsed;
+    int httpCode;
+    String cursor;
+    JsonDocument response;  // Only filled when someone is waiting
+    std::condition_variable changed;
+};
+
+// GETs, and the POSTs that only read state
+bool AptosSDK::readOnlyRequest(const String& endpoint, const String& method) {
+    if (method == "GET") {
+        return true;
+    }
+    return endpoint.startsWith("view") || endpoint.startsWith("tables/");
+}
+
+bool AptosSDK::sendHttpRequest(const String& endpoint, JsonDocument& response, const String& method,
+                              const uint8_t* body, Stream* requestBody, size_t bodyLength,
+                              const char* contentType, const JsonDocument* filter, String* cursor,
+                              int* status) {
+    if (method != "GET" && method != "POST") {
+        logDebug("Unsupported HTTP method: " + method);
+        return false;
+    }
     
+    HttpRequest request = {&endpoint, &method, body, requestBody, bodyLength, contentType, cursor, status};
+    bool readOnly = requestBody == nullptr && readOnlyRequest(endpoint, method);
+    
+    std::unique_lock<std::mutex> lock(sharedMutex);
+    if (!readOnly) {
+        // Reads in flight from before this write must not answer later ones
+        writeGeneration++;
+    }
+    if (!readOnly || !coalescing) {
+        lock.unlock();
+        return routeHttpRequest(request, response, filter);
+    }
+    coalesceRequests++;
+    
+    // A filter is only known by its address; two callers with the same
+    // filter at the same time share the object
+    String key = method + " " + endpoint + " " + String((unsigned long)(uintptr_t)filter);
+    if (bodyLength > 0) {
+        key += "\n";
+        key.concat((const char*)body, bodyLength);
+    }
+    
+    std::shared_ptr<SharedRead>* freeSlot = nullptr;
+    for (size_t i = 0; i < APTOS_COALESCE_MAX_READS; i++) {
+        std::shared_ptr<SharedRead>& slot = sharedReads[i];
+        if (!slot) {
+            freeSlot = freeSlot != nullptr ? freeSlot : &slot;
+        } else if (slot->generation == writeGeneration && slot->key == key) {
+            // Same read already on its way: wait for its answer
+            std::shared_ptr<SharedRead> read = slot;
+            read->waiters++;
+            read->changed.wait(lock, [&read]() { return read->done; });
+            coalescedReads++;
+            logDebug("Coalesced: " + endpoint);
+            if (status != nullptr) {
+                *status = read->httpCode;
+            }
+            if (cursor != nullptr) {
+                *cursor = read->cursor;
+            }
+            response = read->response;
+            return read->parsed;
+        }
+    }
+    if (freeSlot == nullptr) {
+        lock.unlock();
+        return routeHttpRequest(request, response, filter);
+    }
+    
+    std::shared_ptr<SharedRead> read = std::make_shared<SharedRead>();
+    read->key = key;
+    read->generation = writeGeneration;
+    read->waiters = 0;
+    read->done = false;
+    read->parsed = false;
+    read->httpCode = 0;
+    *freeSlot = read;
+    lock.unlock();
+    
+    // The cursor and code are kept for waiters that page through the same listing
+    request.cursor = &read->cursor;
+    request.status = &read->httpCode;
+    bool parsed = routeHttpRequest(request, response, filter);
+    
+    lock.lock();
+    freeSlot->reset();
+    read->parsed = parsed;
+    if (status != nullptr) {
+        *status = read->httpCode;
+    }
+    if (cursor != nullptr) {
+        *cursor = read->cursor;
+    }
+    if (read->waiters > 0) {
+        read->response = response;
+    }
+    read->done = true;
+    read->changed.notify_all();
+    return parsed;
+}
+
+bool AptosSDK::routeHttpRequest(const HttpRequest& request, JsonDocument& response,
+                               const JsonDocument* filter) {
+    // Requests from several tasks take turns
+    std::lock_guard<std::mutex> guard(httpMutex);
+    
+    bool sticky = submissionEndpoint(*request.endpoint);
+    if (hedging && !sticky && request.requestBody == nullptr && nodes.size() > 1) {
+        bool parsed;
+        if (hedgedRequest(request, filter, response, parsed)) {
+            return parsed;
+        }
+    }
+    
+    HttpChannel& channel = idleChannel();
+    uint32_t tried = 0;
+    int httpCode;
+    while (true) {
+        int node = nodes.pick(sticky, tried);
+        tried |= 1u << node;
+        httpCode = exchange(channel, node, request);
+        
+        // Reads are repeated on the next node. A submission only when this
+        // node never got it, so it cannot end up in two mempools.
+        bool retry = nodeFailure(httpCode) && (httpCode == HTTPC_ERROR_CONNECTION_REFUSED ||
+                                               (!sticky && request.requestBody == nullptr));
+        if (!retry || !nodes.untried(tried)) {
+            break;
+        }
+        logDebug("Failing over from " + nodes.url(node));
+        channel.client.end();
+    }
+    lastHttpCode = httpCode;
+    if (request.status != nullptr) {
+        *request.status = httpCode;
+    }
+    
+    return readResponse(channel, httpCode, response, filter, request.cursor);
+}
+
+bool AptosSDK::fetchPage(const String& endpoint, JsonDocument& response, String& cursor,
+                         const JsonDocument* filter) {
+    cursor = "";
+    return sendHttpRequest(endpoint, response, "GET", nullptr, nullptr, 0, APTOS_CONTENT_TYPE_JSON,
+                           filter, &cursor);
+}
+
+bool AptosSDK::nodeFailure(int httpCode) {
+    return httpCode <= 0 || httpCode == 429 || httpCode >= 500;
+}
+
+AptosSDK::HttpChannel& AptosSDK::idleChannel() {
+    for (size_t i = 0; i < APTOS_HTTP_CHANNELS; i++) {
+        if (!channels[i].busy) {
+            if (channels[i].worker.joinable()) {
+                channels[i].worker.join();
+            }
+            return channels[i];
+        }
+    }
+    // Every channel is finishing a hedged attempt
+    channels[0].worker.join();
+    return channels[0];
+}
+
+int AptosSDK::exchange(HttpChannel& channel, int node, const HttpRequest& request) {
+    HTTPClient& http = channel.client;
+    if (node != channel.node) {
+        // A kept-alive connection belongs to the previous node
+        http.setReuse(false);
+        http.end();
+        http.setReuse(true);
+        channel.node = node;
+    }
+    
+    String url = formatUrl(node, *request.endpoint);
+    logDebug("Making " + *request.method + " request to: " + url);
+    
+    http.setTimeout(timeout);
     http.begin(url);
-    http.addHeader("Content-Type", "application/json");
+    http.addHeader("Content-Type", request.contentType);
     http.addHeader("Accept", "application/json");
     
+    const char* headerKeys[] = {"Transfer-Encoding", "X-Aptos-Chain-Id", "X-Aptos-Ledger-Version",
+                                "X-Aptos-Ledger-TimestampUsec", "X-Aptos-Cursor"};
+    http.collectHeaders(headerKeys, 5);
+    
+    unsigned long started = millis();
     int httpCode;
-    if (method == "GET") {
+    if (*request.method == "GET") {
         httpCode = http.GET();
-    } else if (method == "POST") {
-        httpCode = http.POST(payload);
     } else {
-        logDebug("Unsupported HTTP method: " + method);
+        // A stream body is copied to the socket piece by piece
+        httpCode = request.requestBody != nullptr
+            ? http.sendRequest("POST", request.requestBody, request.bodyLength)
+            : http.POST((uint8_t*)request.body, request.bodyLength);
+    }
+    logDebug("HTTP response code: " + String(httpCode));
+    
+    nodes.report(node, !nodeFailure(httpCode), millis() - started, httpCode == HTTPC_ERROR_CONNECTION_REFUSED);
+    return httpCode;
+}
+
+bool AptosSDK::readResponse(HttpChannel& channel, int httpCode, JsonDocument& response,
+                            const JsonDocument* filter, String* cursor) {
+    HTTPClient& http = channel.client;
+    if (httpCode <= 0) {
+        logDebug("HTTP request failed with code: " + String(httpCode));
+        http.end();
         return false;
     }
     
-    logDebug("HTTP response code: " + String(httpCode));
+    // Every answer, errors included, carries the ledger state
+    String chainHeader = http.header("X-Aptos-Chain-Id");
+    if (!chainHeader.isEmpty()) {
+        recordLedgerInfo((uint8_t)chainHeader.toInt(),
+                         strtoull(http.header("X-Aptos-Ledger-Version").c_str(), nullptr, 10),
+                         strtoull(http.header("X-Aptos-Ledger-TimestampUsec").c_str(), nullptr, 10));
+    }
+    if (cursor != nullptr) {
+        // Start of the next page of a paginated listing, absent on the last
+        *cursor = http.header("X-Aptos-Cursor");
+    }
     
-    if (httpCode > 0) {
-        String responseBody = http.getString();
-        logDebug("Response body length: " + String(responseBody.length()));
+    int contentLength = http.getSize();
+    if (maxResponseSize > 0 && contentLength > 0 && (size_t)contentLength > maxResponseSize) {
+        logDebug("Response body too large: " + String(contentLength) + " bytes");
+        http.end();
+        return false;
+    }
+    
+    Stream* stream = http.getStreamPtr();
+    if (stream == nullptr) {
+        logDebug("No response stream");
+        http.end();
+        return false;
+    }
+    
+    // Parse straight from the socket; the body is never copied into a String
+    bool chunked = http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+    AptosHttpBodyStream bodyStream(*stream, contentLength, chunked, maxResponseSize);
+    DeserializationError error = filter
+        ? deserializeJson(response, bodyStream, DeserializationOption::Filter(*filter))
+        : deserializeJson(response, bodyStream);
+    bodyStream.drain();
+    logDebug("Response body length: " + String((unsigned long)bodyStream.bytesRead()));
+    
+    http.end();
+    
+    if (bodyStream.exceededLimit()) {
+        logDebug("Response body exceeds " + String((unsigned long)maxResponseSize) + " bytes");
+        return false;
+    }
+    
+    if (error) {
+        logDebug("JSON parsing failed: " + String(error.c_str()));
+        return false;
+    }
+    
+    return true;
+}
+
+// A hedged read owns copies of everything its attempts touch: the loser
+// keeps running after the caller has returned
+struct AptosSDK::HedgedRead {
+    String endpoint;
+    String method;
+    String contentType;
+    std::vector<uint8_t> body;
+    JsonDocument filter;
+    bool filtered;
+    HttpRequest request;
+    
+    std::mutex lock;
+    std::condition_variable changed;
+    int codes[2];
+    bool parsed[2];
+    bool finished[2];
+    int winner;
+    String cursors[2];
+    JsonDocument responses[2];
+};
+
+void AptosSDK::startAttempt(std::shared_ptr<HedgedRead> read, int attempt, HttpChannel& channel, int node) {
+    channel.busy = true;
+#ifdef ESP32
+    // HTTPClient (and TLS) need more than the default pthread stack
+    esp_pthread_cfg_t config = esp_pthread_get_default_config();
+    config.stack_size = APTOS_HEDGE_STACK_SIZE;
+    esp_pthread_set_cfg(&config);
+#endif
+    channel.worker = std::thread([this, read, attempt, &channel, node]() {
+        int httpCode = exchange(channel, node, read->request);
+        bool parsed = readResponse(channel, httpCode, read->responses[attempt],
+                                   read->filtered ? &read->filter : nullptr, &read->cursors[attempt]);
+        channel.busy = false;
         
-        DeserializationError error = deserializeJson(response, responseBody);
-        if (error) {
-            logDebug("JSON parsing failed: " + String(error.c_str()));
-            http.end();
-            return false;
+        std::lock_guard<std::mutex> guard(read->lock);
+        read->codes[attempt] = httpCode;
+        read->parsed[attempt] = parsed;
+        read->finished[attempt] = true;
+        if (parsed && !nodeFailure(httpCode) && read->winner < 0) {
+            read->winner = attempt;
         }
-        
-        http.end();
+        read->changed.notify_all();
+    });
+}
+
+uint32_t AptosSDK::hedgeDelay(int node) {
+    uint32_t delayMs = nodes.percentile(node, hedgePercentile);
+    if (delayMs == 0) {
+        return APTOS_HEDGE_DEFAULT_DELAY_MS;
+    }
+    return delayMs < APTOS_HEDGE_MIN_DELAY_MS ? APTOS_HEDGE_MIN_DELAY_MS : delayMs;
+}
+
+bool AptosSDK::hedgedRequest(const HttpRequest& request, const JsonDocument* filter,
+                            JsonDocument& response, bool& parsed) {
+    // Needs two free connections; the loser of an earlier hedge may still
+    // be waiting for its node
+    HttpChannel* free[2];
+    size_t freeCount = 0;
+    for (size_t i = 0; i < APTOS_HTTP_CHANNELS && freeCount < 2; i++) {
+        if (!channels[i].busy) {
+            if (channels[i].worker.joinable()) {
+                channels[i].worker.join();
+            }
+            free[freeCount++] = &channels[i];
+        }
+    }
+    if (freeCount < 2) {
+        return false;
+    }
+    int primary = nodes.pick(false, 0);
+    int backup = nodes.pick(false, 1u << primary);
+    if (backup < 0) {
+        return false;
+    }
+    
+    std::shared_ptr<HedgedRead> read = std::make_shared<HedgedRead>();
+    read->endpoint = *request.endpoint;
+    read->method = *request.method;
+    read->contentType = request.contentType;
+    read->body.assign(request.body, request.body + request.bodyLength);
+    read->filtered = filter != nullptr;
+    if (filter != nullptr) {
+        read->filter = *filter;
+    }
+    read->request = {&read->endpoint, &read->method, read->body.data(), nullptr, read->body.size(),
+                     read->contentType.c_str(), nullptr, nullptr};
+    for (int i = 0; i < 2; i++) {
+        read->codes[i] = 0;
+        read->parsed[i] = false;
+        read->finished[i] = false;
+    }
+    read->winner = -1;
+    
+    hedgeRequests++;
+    startAttempt(read, 0, *free[0], primary);
+    
+    std::unique_lock<std::mutex> lock(read->lock);
+    // Waits out the primary's usual latency; a primary that fails early
+    // sends the hedge at once
+    read->changed.wait_for(lock, std::chrono::milliseconds(hedgeDelay(primary)),
+                           [&read]() { return read->winner >= 0 || read->finished[0]; });
+    bool fired = false;
+    if (read->winner < 0) {
+        lock.unlock();
+        logDebug("Hedging to " + nodes.url(backup));
+        startAttempt(read, 1, *free[1], backup);
+        hedgesFired++;
+        fired = true;
+        lock.lock();
+    }
+    read->changed.wait(lock, [&read, fired]() {
+        return read->winner >= 0 || (read->finished[0] && (!fired || read->finished[1]));
+    });
+    
+    // The first good answer, otherwise the one that got through at all
+    int result = read->winner;
+    if (result < 0) {
+        result = fired && read->codes[0] <= 0 && read->codes[1] > 0 ? 1 : 0;
+    }
+    if (read->winner == 1) {
+        hedgesWon++;
+    }
+    lastHttpCode = read->codes[result];
+    if (request.status != nullptr) {
+        *request.status = read->codes[result];
+    }
+    parsed = read->parsed[result];
+    if (request.cursor != nullptr) {
+        *request.cursor = read->cursors[result];
+    }
+    response = std::move(read->responses[result]);
+    return true;
+}
+
+bool AptosSDK::cachedRequest(const String& endpoint, JsonDocument& response, const String& method,
+                            const String& payload, bool pinned, const JsonDocument* filter) {
+    // The filter shapes the stored document, so it is part of the key; only
+    // the presets have a stable identity
+    String key = method + " " + endpoint;
+    if (filter != nullptr) {
+        int preset = 0;
+        while (preset < APTOS_FILTER_COUNT && responseFilter((AptosResponseFilter)preset) != filter) {
+            preset++;
+        }
+        if (preset == APTOS_FILTER_COUNT) {
+            return makeHttpRequest(endpoint, response, method, payload, filter);
+        }
+        key += " #" + String(preset);
+    }
+    if (!payload.isEmpty()) {
+        key += "\n" + payload;
+    }
+    
+    if (!responseCache.enabled()) {
+        return makeHttpRequest(endpoint, response, method, payload, filter);
+    }
+    if (responseCache.get(key, response)) {
+        logDebug("Cache hit: " + endpoint);
         return true;
-    } else {
-        logDebug("HTTP request failed with code: " + String(httpCode));
-        http.end();
+    }
+    
+    int httpCode = 0;
+    if (!makeHttpRequest(endpoint, response, method, payload, filter, &httpCode)) {
         return false;
     }
+    // Errors (missing resources included) are not cached
+    if (httpCode == 200 && response["error_code"].isNull()) {
+        responseCache.put(key, response, pinned);
+    }
+    return true;
 }
 
 bool AptosSDK::getNodeInfo(JsonDocument& response) {
     return makeHttpRequest("", response, "GET");
 }
 
-bool AptosSDK::getLedgerInfo(JsonDocument& response) {
-    return makeHttpRequest("", response, "GET");
+bool AptosSDK::getLedgerInfo(JsonDocument& response, const JsonDocument* filter) {
+    return makeHttpRequest("", response, "GET", "", filter);
 }
 
 bool AptosSDK::getBlockByHeight(uint64_t height, JsonDocument& response) {
-    return makeHttpRequest("blocks/by_height/" + String((unsigned long)height), response, "GET");
+    return makeHttpRequest("blocks/by_height/" + AptosUtils::toDecimalString(height), response, "GET");
 }
 
 bool AptosSDK::getBlockByVersion(uint64_t version, JsonDocument& response) {
-    return makeHttpRequest("blocks/by_version/" + String((unsigned long)version), response, "GET");
+    return makeHttpRequest("blocks/by_version/" + AptosUtils::toDecimalString(version), response, "GET");
 }
 
-bool AptosSDK::getAccount(const String& address, JsonDocument& response, uint64_t ledgerVersion) {
-    if (!isValidAddress(address)) {
-        logDebug("Invalid address: " + address);
-        return false;
-    }
-    
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr;
+bool AptosSDK::getAccount(const String& address, JsonDocument& response, uint64_t ledgerVersion,
+                          const JsonDocument* filter) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccount(parsed, response, ledgerVersion, filter);
+}
+
+bool AptosSDK::getAccount(const AccountAddress& address, JsonDocument& response, uint64_t ledgerVersion,
+                          const JsonDocument* filter) {
+    String endpoint = accountEndpoint(address);
     
     if (ledgerVersion > 0) {
-        endpoint += "?ledger_version=" + String((unsigned long)ledgerVersion);
+        endpoint += "?ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     
-    return makeHttpRequest(endpoint, response, "GET");
+    return makeHttpRequest(endpoint, response, "GET", "", filter);
 }
 
 bool AptosSDK::getAccountBalance(const String& address, const String& assetType, JsonDocument& response, uint64_t ledgerVersion) {
-    if (!isValidAddress(address)) {
-        logDebug("Invalid address: " + address);
-        return false;
-    }
-    
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/balance/" + assetType;
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountBalance(parsed, assetType, response, ledgerVersion);
+}
+
+bool AptosSDK::getAccountBalance(const AccountAddress& address, const String& assetType, JsonDocument& response, uint64_t ledgerVersion) {
+    String endpoint = accountEndpoint(address) + "/balance/" + assetType;
     
     if (ledgerVersion > 0) {
-        endpoint += "?ledger_version=" + String((unsigned long)ledgerVersion);
+        endpoint += "?ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     
     return makeHttpRequest(endpoint, response, "GET");
 }
 
 bool AptosSDK::getAccountTransactions(const String& address, JsonDocument& response, 
-                                     int limit, int start) {
-    if (!isValidAddress(address)) {
-        return false;
-    }
-    
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/transactions?limit=" + 
+                                     int limit, int start, const JsonDocument* filter) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountTransactions(parsed, response, limit, start, filter);
+}
+
+bool AptosSDK::getAccountTransactions(const AccountAddress& address, JsonDocument& response, 
+                                     int limit, int start, const JsonDocument* filter) {
+    String endpoint = accountEndpoint(address) + "/transactions?limit=" + 
                      String(limit) + "&start=" + String(start);
-    return makeHttpRequest(endpoint, response, "GET");
+    return makeHttpRequest(endpoint, response, "GET", "", filter);
 }
 
 bool AptosSDK::getAccountResources(const String& address, JsonDocument& response,
-                                   uint64_t ledgerVersion, const String& start, int limit) {
-    if (!isValidAddress(address)) {
-        return false;
+                                   uint64_t ledgerVersion, const String& start, int limit,
+                                   const JsonDocument* filter) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountResources(parsed, response, ledgerVersion, start, limit, filter);
+}
+
+bool AptosSDK::getAccountResources(const AccountAddress& address, JsonDocument& response,
+                                   uint64_t ledgerVersion, const String& start, int limit,
+                                   const JsonDocument* filter) {
+    String endpoint = accountEndpoint(address) + "/resources";
+    
+    String params = "";
+    if (ledgerVersion > 0) {
+        params += "ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
+    }
+    if (!start.isEmpty()) {
+        if (!params.isEmpty()) params += "&";
+        params += "start=" + start;
+    }
+    if (limit > 0) {
+        if (!params.isEmpty()) params += "&";
+        params += "limit=" + String(limit);
+    }
+    
+    if (!params.isEmpty()) {
+        endpoint += "?" + params;
+    }
+    
+    return makeHttpRequest(endpoint, response, "GET", "", filter);
+}
+
+bool AptosSDK::getAccountResource(const String& address, const String& resourceType,
+                                 JsonDocument& response, uint64_t ledgerVersion,
+                                 const JsonDocument* filter) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountResource(parsed, resourceType, response, ledgerVersion, filter);
+}
+
+bool AptosSDK::getAccountResource(const AccountAddress& address, const String& resourceType,
+                                 JsonDocument& response, uint64_t ledgerVersion,
+                                 const JsonDocument* filter) {
+    String endpoint = accountEndpoint(address) + "/resource/" + resourceType;
+    
+    if (ledgerVersion > 0) {
+        endpoint += "?ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/resources";
+    return cachedRequest(endpoint, response, "GET", "", ledgerVersion > 0, filter);
+}
+
+bool AptosSDK::getAccountModules(const String& address, JsonDocument& response,
+                                uint64_t ledgerVersion, const String& start, int limit) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountModules(parsed, response, ledgerVersion, start, limit);
+}
+
+bool AptosSDK::getAccountModules(const AccountAddress& address, JsonDocument& response,
+                                uint64_t ledgerVersion, const String& start, int limit) {
+    String endpoint = accountEndpoint(address) + "/modules";
     
     String params = "";
     if (ledgerVersion > 0) {
-        params += "ledger_version=" + String((unsigned long)ledgerVersion);
+        params += "ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     if (!start.isEmpty()) {
         if (!params.isEmpty()) params += "&";
@@ -169,103 +807,289 @@ bool AptosSDK::getAccountResources(const String& address, JsonDocument& response
     return makeHttpRequest(endpoint, response, "GET");
 }
 
-bool AptosSDK::getAccountResource(const String& address, const String& resourceType,
-                                 JsonDocument& response, uint64_t ledgerVersion) {
-    if (!isValidAddress(address)) {
-        return false;
+bool AptosSDK::getAccountModule(const String& address, const String& moduleName,
+                               JsonDocument& response, uint64_t ledgerVersion) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountModule(parsed, moduleName, response, ledgerVersion);
+}
+
+bool AptosSDK::getAccountModule(const AccountAddress& address, const String& moduleName,
+                               JsonDocument& response, uint64_t ledgerVersion) {
+    String endpoint = accountEndpoint(address) + "/module/" + moduleName;
+    
+    if (ledgerVersion > 0) {
+        endpoint += "?ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/resource/" + resourceType;
+    return cachedRequest(endpoint, response, "GET", "", ledgerVersion > 0);
+}
+
+bool AptosSDK::getAccountEvents(const String& address, const String& eventHandle,
+                               JsonDocument& response, int limit, uint64_t start) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountEvents(parsed, eventHandle, response, limit, start);
+}
+
+bool AptosSDK::getAccountEvents(const AccountAddress& address, const String& eventHandle,
+                               JsonDocument& response, int limit, uint64_t start) {
+    String endpoint = accountEndpoint(address) + "/events/" + eventHandle;
     
-    if (ledgerVersion > 0) {
-        endpoint += "?ledger_version=" + String((unsigned long)ledgerVersion);
+    String params = "limit=" + String(limit);
+    if (start != APTOS_EVENTS_LATEST) {
+        params += "&start=" + AptosUtils::toDecimalString(start);
     }
     
+    endpoint += "?" + params;
     return makeHttpRequest(endpoint, response, "GET");
 }
 
-bool AptosSDK::getAccountModules(const String& address, JsonDocument& response,
-                                uint64_t ledgerVersion, const String& start, int limit) {
-    if (!isValidAddress(address)) {
-        return false;
-    }
-    
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/modules";
-    
-    String params = "";
-    if (ledgerVersion > 0) {
-        params += "ledger_version=" + String((unsigned long)ledgerVersion);
-    }
-    if (!start.isEmpty()) {
-        if (!params.isEmpty()) params += "&";
-        params += "start=" + start;
-    }
-    if (limit > 0) {
-        if (!params.isEmpty()) params += "&";
-        params += "limit=" + String(limit);
+bool AptosSDK::getTransactionByHash(const String& txnHash, JsonDocument& response,
+                                    const JsonDocument* filter) {
+    return makeHttpRequest("transactions/by_hash/" + txnHash, response, "GET", "", filter);
+}
+
+bool AptosSDK::getTransactionByVersion(uint64_t version, JsonDocument& response,
+                                       const JsonDocument* filter) {
+    return makeHttpRequest("transactions/by_version/" + AptosUtils::toDecimalString(version), response, "GET", "", filter);
+}
+
+bool AptosSDK::getTransactions(JsonDocument& response, int limit, int start, const JsonDocument* filter) {
+    String endpoint = "transactions?limit=" + String(limit) + "&start=" + String(start);
+    return makeHttpRequest(endpoint, response, "GET", "", filter);
+}
+
+bool AptosSDK::submitTransaction(const JsonDocument& transaction, JsonDocument& response) {
+    String payload;
+    serializeJson(transaction, payload);
+    logDebug("Submitting transaction: " + payload);
+    return makeHttpRequest("transactions", response, "POST", payload);
+}
+
+bool AptosSDK::submitTransactionBCS(const uint8_t* signedTxn, size_t length, JsonDocument& response) {
+    return postTransactionBCS(signedTxn, length, response, nullptr);
+}
+
+bool AptosSDK::postTransactionBCS(const uint8_t* signedTxn, size_t length, JsonDocument& response,
+                                  int* status) {
+    logDebug("Submitting BCS transaction: " + String((unsigned long)length) + " bytes");
+    return makeHttpRequest("transactions", response, "POST", signedTxn, length,
+                           APTOS_CONTENT_TYPE_SIGNED_TXN_BCS, nullptr, status);
+}
+
+int AptosSDK::sequenceNumberError(const JsonDocument& response) {
+    int vmError = response["vm_error_code"].as<int>();
+    if (vmError == APTOS_VM_SEQUENCE_NUMBER_TOO_OLD || vmError == APTOS_VM_SEQUENCE_NUMBER_TOO_NEW) {
+        return vmError;
+    }
+    String message = AptosUtils::getJsonString(response, "message", "");
+    if (message.indexOf("SEQUENCE_NUMBER_TOO_OLD") >= 0) {
+        return APTOS_VM_SEQUENCE_NUMBER_TOO_OLD;
+    }
+    if (message.indexOf("SEQUENCE_NUMBER_TOO_NEW") >= 0) {
+        return APTOS_VM_SEQUENCE_NUMBER_TOO_NEW;
+    }
+    return 0;
+}
+
+bool AptosSDK::fetchSequenceNumber(const AccountAddress& address, uint64_t& sequenceNumber) {
+    JsonDocument accountInfo;
+    if (!getAccount(address, accountInfo, 0, responseFilter(APTOS_FILTER_ACCOUNT)) ||
+        accountInfo["sequence_number"].isNull()) {
+        logDebug("Failed to get sender account info");
+        return false;
+    }
+    sequenceNumber = AptosUtils::getJsonUint64(accountInfo, "sequence_number", 0);
+    return true;
+}
+
+bool AptosSDK::nextSequenceNumber(const AccountAddress& address, uint64_t& sequenceNumber) {
+    if (localSequenceNumbers && sequenceNumbers.allocate(address, sequenceNumber)) {
+        return true;
+    }
+    
+    uint64_t onChain;
+    if (!fetchSequenceNumber(address, onChain)) {
+        return false;
+    }
+    sequenceNumber = localSequenceNumbers ? sequenceNumbers.seedAndAllocate(address, onChain) : onChain;
+    logDebug("Sequence number " + String((unsigned long)sequenceNumber) + " for " + address.toString());
+    return true;
+}
+
+bool AptosSDK::cachedChainId(uint8_t& chainId) {
+    // Fixed for a node URL; usually known from an earlier response header
+    if (!getChainId(chainId)) {
+        logDebug("Failed to get chain ID");
+        return false;
+    }
+    return true;
+}
+
+void AptosSDK::recordLedgerInfo(uint8_t chainId, uint64_t ledgerVersion, uint64_t ledgerTimestampUsec) {
+    std::lock_guard<std::mutex> guard(metadataMutex);
+    if (chainId != 0) {
+        chainMetadata.chainId = chainId;
+    }
+    // A lagging answer must not move the clock back
+    if (ledgerTimestampUsec != 0 && ledgerVersion >= chainMetadata.ledgerVersion) {
+        chainMetadata.ledgerVersion = ledgerVersion;
+        chainMetadata.ledgerTimestampUsec = ledgerTimestampUsec;
+        chainMetadata.ledgerUpdatedMs = millis();
+    }
+}
+
+bool AptosSDK::fetchLedgerInfo() {
+    JsonDocument response;
+    if (!getLedgerInfo(response, responseFilter(APTOS_FILTER_LEDGER_INFO)) || response["chain_id"].isNull()) {
+        return false;
+    }
+    recordLedgerInfo(response["chain_id"].as<uint8_t>(), AptosUtils::getJsonUint64(response, "ledger_version"),
+                     AptosUtils::getJsonUint64(response, "ledger_timestamp"));
+    return true;
+}
+
+bool AptosSDK::fetchGasPrice(uint64_t& gasPrice) {
+    JsonDocument response;
+    if (!makeHttpRequest("estimate_gas_price", response, "GET", "", responseFilter(APTOS_FILTER_GAS_ESTIMATE)) ||
+        response["gas_estimate"].isNull()) {
+        return false;
+    }
+    gasPrice = response["gas_estimate"].as<uint64_t>();
+    
+    std::lock_guard<std::mutex> guard(metadataMutex);
+    chainMetadata.gasEstimate = gasPrice;
+    chainMetadata.prioritizedGasEstimate = response["prioritized_gas_estimate"].as<uint64_t>();
+    chainMetadata.deprioritizedGasEstimate = response["deprioritized_gas_estimate"].as<uint64_t>();
+    chainMetadata.gasUpdatedMs = millis();
+    return true;
+}
+
+uint64_t AptosSDK::gasUnitPrice() {
+    uint64_t gasPrice;
+    if (estimateGasPrice(gasPrice) && gasPrice > 0) {
+        return gasPrice;
+    }
+    logDebug("No gas estimate, using the default gas price");
+    return AptosTransaction::DEFAULT_GAS_PRICE;
+}
+
+bool AptosSDK::signAndSubmit(AptosAccount& sender, AptosTransaction& txn, JsonDocument& response) {
+    const AccountAddress& address = sender.getAccountAddress();
+    
+    for (int attempt = 0; ; attempt++) {
+        bool posted;
+        if (submitSigned(sender, txn, response, posted)) {
+            return true;
+        }
+        
+        if (!posted) {
+            // Never left the device, so the number is still free
+            sequenceNumbers.release(address, txn.getSequenceNumber());
+            return false;
+        }
+        
+        int sequenceError = sequenceNumberError(response);
+        if (sequenceError == 0) {
+            if (!response["error_code"].isNull()) {
+                // Rejected before reaching mempool
+                sequenceNumbers.release(address, txn.getSequenceNumber());
+            } else {
+                // Transport failure: the node may or may not have it
+                sequenceNumbers.invalidate(address);
+            }
+            return false;
+        }
+        
+        // The local view is stale (another device, an expired transaction, ...):
+        // re-sync from the node and retry with a fresh number
+        uint64_t onChain;
+        if (!localSequenceNumbers || attempt >= APTOS_SEQUENCE_MAX_RESYNCS ||
+            !fetchSequenceNumber(address, onChain)) {
+            sequenceNumbers.invalidate(address);
+            return false;
+        }
+        
+        uint64_t sequenceNumber;
+        if (sequenceError == APTOS_VM_SEQUENCE_NUMBER_TOO_OLD) {
+            // The rejected number may be held by a pending transaction that the
+            // committed sequence number does not count yet
+            uint64_t minimum = txn.getSequenceNumber() + 1;
+            sequenceNumber = sequenceNumbers.advanceAndAllocate(address, onChain > minimum ? onChain : minimum);
+        } else {
+            sequenceNumbers.invalidate(address);
+            sequenceNumber = sequenceNumbers.seedAndAllocate(address, onChain);
+        }
+        
+        logDebug("Retrying with sequence number " + String((unsigned long)sequenceNumber));
+        txn.setSequenceNumber(sequenceNumber);
+        response.clear();
+    }
+}
+
+bool AptosSDK::submitSigned(AptosAccount& sender, AptosTransaction& txn, JsonDocument& response, bool& posted) {
+    posted = false;
+    if (submitMode == APTOS_SUBMIT_BCS && txn.hasBCSPayload()) {
+        if (txn.getChainId() == 0) {
+            uint8_t chainId;
+            if (!cachedChainId(chainId)) {
+                return false;
+            }
+            txn.setChainId(chainId);
+        }
+        
+        AptosBCSWriter signedTxn(256);
+        if (!sender.signTransaction(txn, signedTxn)) {
+            logDebug("Failed to sign transaction: " + txn.getError());
+            return false;
+        }
+
+        // Known before the node answers; hashed straight from the BCS buffer
+        String localHash = AptosUtils::generateTransactionHash(signedTxn.data(), signedTxn.size());
+        logDebug("Submitting transaction " + localHash);
+
+        posted = true;
+        if (!submitTransactionBCS(signedTxn.data(), signedTxn.size(), response)) {
+            return false;
+        }
+
+        // Rejections (bad sequence number, expired, ...) come back as JSON errors
+        if (!response["error_code"].isNull()) {
+            logDebug("Transaction rejected: " + AptosUtils::getJsonString(response, "message", ""));
+            return false;
+        }
+
+        if (response["hash"].isNull()) {
+            response["hash"] = localHash;
+        }
+        return true;
     }
     
-    if (!params.isEmpty()) {
-        endpoint += "?" + params;
+    if (submitMode == APTOS_SUBMIT_BCS) {
+        logDebug("Payload has no BCS encoding, submitting as JSON");
     }
     
-    return makeHttpRequest(endpoint, response, "GET");
-}
-
-bool AptosSDK::getAccountModule(const String& address, const String& moduleName,
-                               JsonDocument& response, uint64_t ledgerVersion) {
-    if (!isValidAddress(address)) {
+    String signedTxn;
+    if (!sender.signTransaction(txn.getTransaction(), signedTxn)) {
+        logDebug("Failed to sign transaction");
         return false;
     }
     
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/module/" + moduleName;
-    
-    if (ledgerVersion > 0) {
-        endpoint += "?ledger_version=" + String((unsigned long)ledgerVersion);
+    JsonDocument signedDoc;
+    if (!AptosUtils::parseJsonSafely(signedTxn, signedDoc)) {
+        logDebug("Failed to parse signed transaction");
+        return false;
     }
     
-    return makeHttpRequest(endpoint, response, "GET");
-}
-
-bool AptosSDK::getAccountEvents(const String& address, const String& eventHandle,
-                               JsonDocument& response, int limit, int start) {
-    if (!isValidAddress(address)) {
+    posted = true;
+    if (!submitTransaction(signedDoc, response)) {
         return false;
     }
     
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/events/" + eventHandle;
-    
-    String params = "limit=" + String(limit);
-    if (start > 0) {
-        params += "&start=" + String(start);
+    if (!response["error_code"].isNull()) {
+        logDebug("Transaction rejected: " + AptosUtils::getJsonString(response, "message", ""));
+        return false;
     }
-    
-    endpoint += "?" + params;
-    return makeHttpRequest(endpoint, response, "GET");
-}
-
-bool AptosSDK::getTransactionByHash(const String& txnHash, JsonDocument& response) {
-    return makeHttpRequest("transactions/by_hash/" + txnHash, response, "GET");
-}
-
-bool AptosSDK::getTransactionByVersion(uint64_t version, JsonDocument& response) {
-    return makeHttpRequest("transactions/by_version/" + String((unsigned long)version), response, "GET");
-}
-
-bool AptosSDK::getTransactions(JsonDocument& response, int limit, int start) {
-    String endpoint = "transactions?limit=" + String(limit) + "&start=" + String(start);
-    return makeHttpRequest(endpoint, response, "GET");
-}
-
-bool AptosSDK::submitTransaction(const JsonDocument& transaction, JsonDocument& response) {
-    String payload;
-    serializeJson(transaction, payload);
-    logDebug("Submitting transaction: " + payload);
-    return makeHttpRequest("transactions", response, "POST", payload);
+    return true;
 }
 
 bool AptosSDK::simulateTransaction(const JsonDocument& transaction, JsonDocument& response,
@@ -297,38 +1121,151 @@ bool AptosSDK::batchSubmitTransactions(const JsonArray& transactions, JsonDocume
     return makeHttpRequest("transactions/batch", response, "POST", payload);
 }
 
-bool AptosSDK::waitForTransactionByVersion(uint64_t version, int maxWaitTime) {
-    unsigned long startTime = millis();
+static String variantString(JsonVariantConst value) {
+    const char* text = value.as<const char*>();
+    return text != nullptr ? String(text) : String();
+}
+
+static void setBatchError(AptosBatchResult& result, JsonVariantConst error) {
+    result.accepted = false;
+    result.vmErrorCode = error["vm_error_code"].as<int>();
+    result.errorCode = variantString(error["error_code"]);
+    result.message = variantString(error["message"]);
+}
+
+bool AptosSDK::batchSubmitTransactionsBCS(const AptosBCSWriter* signedTxns, size_t count,
+                                          AptosBatchResult* results) {
+    for (size_t i = 0; i < count; i++) {
+        results[i].accepted = false;
+        results[i].vmErrorCode = 0;
+        results[i].errorCode = "";
+        results[i].message = "";
+    }
+    if (count == 0) {
+        return true;
+    }
+    
+    // vector<SignedTransaction>, streamed from the callers' buffers
+    AptosBCSVectorStream body(signedTxns, count);
+    logDebug("Submitting batch of " + String((unsigned long)count) + " BCS transactions: " +
+             String((unsigned long)body.size()) + " bytes");
+    
     JsonDocument response;
+    if (!makeHttpRequest("transactions/batch", response, body, body.size(), APTOS_CONTENT_TYPE_SIGNED_TXN_BCS,
+                         responseFilter(APTOS_FILTER_BATCH_FAILURES))) {
+        return false;
+    }
     
-    while ((millis() - startTime) < (maxWaitTime * 1000)) {
-        if (getTransactionByVersion(version, response)) {
-            if (response.containsKey("success") && response["success"].as<bool>()) {
-                return true;
-            }
+    // The batch as a whole was refused (malformed, too large, ...)
+    if (!response["error_code"].isNull()) {
+        logDebug("Batch rejected: " + AptosUtils::getJsonString(response, "message", ""));
+        for (size_t i = 0; i < count; i++) {
+            setBatchError(results[i], response.as<JsonVariantConst>());
         }
-        delay(1000);
+        return false;
     }
     
-    logDebug("Transaction wait timeout for version: " + String((unsigned long)version));
-    return false;
+    // 202 lists no failures, 206 lists the refused ones by index
+    for (size_t i = 0; i < count; i++) {
+        results[i].accepted = true;
+    }
+    for (JsonVariantConst failure : response["transaction_failures"].as<JsonArrayConst>()) {
+        size_t index = failure["transaction_index"].as<size_t>();
+        if (index < count) {
+            setBatchError(results[index], failure["error"]);
+        }
+    }
+    return true;
 }
 
-bool AptosSDK::waitForTransaction(const String& txnHash, int maxWaitTime) {
+AptosTransactionStatus AptosSDK::transactionStatus(const JsonDocument& transaction) {
+    if (!transaction["success"].isNull()) {
+        return transaction["success"].as<bool>() ? APTOS_TXN_SUCCESS : APTOS_TXN_FAILED;
+    }
+    if (AptosUtils::getJsonString(transaction, "type", "") == "pending_transaction") {
+        return APTOS_TXN_PENDING;
+    }
+    if (AptosUtils::getJsonString(transaction, "error_code", "") == "transaction_not_found") {
+        return APTOS_TXN_NOT_FOUND;
+    }
+    return APTOS_TXN_ERROR;
+}
+
+AptosTransactionStatus AptosSDK::waitForCommit(const String& txnHash, uint64_t version, JsonDocument& transaction,
+                                               uint32_t timeoutMs, const JsonDocument* filter) {
     unsigned long startTime = millis();
-    JsonDocument response;
+    uint32_t pollDelay = APTOS_WAIT_POLL_INITIAL_MS;
+    AptosTransactionStatus status = APTOS_TXN_ERROR;
+    bool seenPending = false;
     
-    while ((millis() - startTime) < (maxWaitTime * 1000)) {
-        if (getTransactionByHash(txnHash, response)) {
-            if (response.containsKey("success") && response["success"].as<bool>()) {
-                return true;
+    while (true) {
+        unsigned long requestStart = millis();
+        transaction.clear();
+        
+        // wait_by_hash holds the request until the transaction leaves mempool
+        // (or the node's own wait limit passes), so no fixed tick is needed
+        bool longPoll = !txnHash.isEmpty() && waitByHashAvailable;
+        bool answered;
+        if (longPoll) {
+            int httpCode = 0;
+            answered = makeHttpRequest("transactions/wait_by_hash/" + txnHash, transaction, "GET", "", filter,
+                                       &httpCode);
+            if (answered && (httpCode == 404 || httpCode == 405) &&
+                AptosUtils::getJsonString(transaction, "error_code", "") != "transaction_not_found") {
+                // Older node without the endpoint: poll by_hash from now on
+                logDebug("wait_by_hash not available, polling instead");
+                waitByHashAvailable = false;
+                continue;
             }
+        } else if (!txnHash.isEmpty()) {
+            answered = getTransactionByHash(txnHash, transaction, filter);
+        } else {
+            answered = getTransactionByVersion(version, transaction, filter);
+        }
+        
+        status = answered ? transactionStatus(transaction) : APTOS_TXN_ERROR;
+        if (status == APTOS_TXN_SUCCESS || status == APTOS_TXN_FAILED) {
+            return status;
         }
-        delay(1000); // Wait 1 second before retry
+        seenPending = seenPending || status == APTOS_TXN_PENDING;
+        
+        unsigned long elapsed = millis() - startTime;
+        if (elapsed >= timeoutMs) {
+            break;
+        }
+        
+        // Back off, minus the time the node already spent holding the request
+        unsigned long spent = millis() - requestStart;
+        if (spent < pollDelay) {
+            unsigned long pause = pollDelay - spent;
+            delay(pause < timeoutMs - elapsed ? pause : timeoutMs - elapsed);
+        }
+        pollDelay = pollDelay + pollDelay / 2 > APTOS_WAIT_POLL_MAX_MS ? APTOS_WAIT_POLL_MAX_MS : pollDelay + pollDelay / 2;
     }
     
-    logDebug("Transaction wait timeout for hash: " + txnHash);
-    return false;
+    if (txnHash.isEmpty()) {
+        logDebug("Transaction wait timeout for version: " + AptosUtils::toDecimalString(version));
+    } else {
+        logDebug("Transaction wait timeout for hash: " + txnHash);
+    }
+    // A transaction seen in mempool may have been answered by a lagging node
+    return seenPending && status == APTOS_TXN_NOT_FOUND ? APTOS_TXN_PENDING : status;
+}
+
+AptosTransactionStatus AptosSDK::waitForTransactionStatus(const String& txnHash, JsonDocument& transaction,
+                                                          uint32_t timeoutMs, const JsonDocument* filter) {
+    return waitForCommit(txnHash, 0, transaction, timeoutMs, filter);
+}
+
+bool AptosSDK::waitForTransactionByVersion(uint64_t version, int maxWaitTime) {
+    JsonDocument transaction;
+    return waitForCommit("", version, transaction, (uint32_t)maxWaitTime * 1000,
+                         responseFilter(APTOS_FILTER_TRANSACTION_STATUS)) == APTOS_TXN_SUCCESS;
+}
+
+bool AptosSDK::waitForTransaction(const String& txnHash, int maxWaitTime) {
+    JsonDocument transaction;
+    return waitForTransactionStatus(txnHash, transaction, (uint32_t)maxWaitTime * 1000) == APTOS_TXN_SUCCESS;
 }
 
 bool AptosSDK::viewFunction(const String& moduleAddress, const String& moduleName,
@@ -341,71 +1278,146 @@ bool AptosSDK::viewFunction(const String& moduleAddress, const String& moduleNam
     
     String payloadStr;
     serializeJson(payload, payloadStr);
-    return makeHttpRequest("view", response, "POST", payloadStr);
+    return cachedRequest("view", response, "POST", payloadStr, false);
+}
+
+bool AptosSDK::viewFunction(const AccountAddress& moduleAddress, const String& moduleName,
+                           const String& functionName, const JsonArray& typeArgs,
+                           const JsonArray& args, JsonDocument& response) {
+    return viewFunction(moduleAddress.toString(), moduleName, functionName, typeArgs, args, response);
 }
 
 bool AptosSDK::getEventsByEventHandle(const String& address, const String& eventHandle,
-                                     JsonDocument& response, int limit) {
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/events/" + eventHandle + 
+                                     JsonDocument& response, int limit, uint64_t start) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getEventsByEventHandle(parsed, eventHandle, response, limit, start);
+}
+
+bool AptosSDK::getEventsByEventHandle(const AccountAddress& address, const String& eventHandle,
+                                     JsonDocument& response, int limit, uint64_t start) {
+    String endpoint = accountEndpoint(address) + "/events/" + eventHandle + 
                      "?limit=" + String(limit);
+    if (start != APTOS_EVENTS_LATEST) {
+        endpoint += "&start=" + AptosUtils::toDecimalString(start);
+    }
     return makeHttpRequest(endpoint, response, "GET");
 }
 
 bool AptosSDK::estimateGasPrice(uint64_t& gasPrice) {
-    JsonDocument response;
-    if (makeHttpRequest("estimate_gas_price", response, "GET")) {
-        gasPrice = response["gas_estimate"].as<uint64_t>();
-        return true;
+    {
+        std::lock_guard<std::mutex> guard(metadataMutex);
+        if (chainMetadata.gasEstimate != 0 && millis() - chainMetadata.gasUpdatedMs < gasPriceTtlMs) {
+            gasPrice = chainMetadata.gasEstimate;
+            return true;
+        }
     }
-    return false;
+    return fetchGasPrice(gasPrice);
 }
 
-bool AptosSDK::isValidAddress(const String& address) {
-    // Remove 0x prefix if present
-    String addr = address;
-    if (addr.startsWith("0x") || addr.startsWith("0X")) {
-        addr = addr.substring(2);
-    }
-    
-    // Check length (should be 1-64 hex characters)
-    if (addr.length() == 0 || addr.length() > 64) {
-        return false;
+void AptosSDK::setGasPriceTtl(uint32_t ttlMs) {
+    gasPriceTtlMs = ttlMs;
+}
+
+// Error fields are kept by every object filter so failures stay readable
+static void addErrorFields(JsonDocument& filter) {
+    filter["message"] = true;
+    filter["error_code"] = true;
+    filter["vm_error_code"] = true;
+}
+
+static void buildResponseFilter(AptosResponseFilter preset, JsonDocument& filter) {
+    switch (preset) {
+        case APTOS_FILTER_LEDGER_INFO:
+            filter["chain_id"] = true;
+            filter["epoch"] = true;
+            filter["ledger_version"] = true;
+            filter["oldest_ledger_version"] = true;
+            filter["ledger_timestamp"] = true;
+            filter["block_height"] = true;
+            filter["oldest_block_height"] = true;
+            break;
+        case APTOS_FILTER_ACCOUNT:
+            filter["sequence_number"] = true;
+            filter["authentication_key"] = true;
+            break;
+        case APTOS_FILTER_GAS_ESTIMATE:
+            filter["gas_estimate"] = true;
+            filter["deprioritized_gas_estimate"] = true;
+            filter["prioritized_gas_estimate"] = true;
+            break;
+        case APTOS_FILTER_TRANSACTION_STATUS:
+            filter["type"] = true;
+            filter["hash"] = true;
+            filter["sender"] = true;
+            filter["version"] = true;
+            filter["success"] = true;
+            filter["vm_status"] = true;
+            filter["sequence_number"] = true;
+            filter["gas_used"] = true;
+            break;
+        case APTOS_FILTER_TRANSACTION_LIST:
+            filter[0]["type"] = true;
+            filter[0]["hash"] = true;
+            filter[0]["version"] = true;
+            filter[0]["success"] = true;
+            filter[0]["vm_status"] = true;
+            filter[0]["sequence_number"] = true;
+            filter[0]["gas_used"] = true;
+            return;
+        case APTOS_FILTER_BATCH_FAILURES:
+            filter["transaction_failures"][0]["transaction_index"] = true;
+            filter["transaction_failures"][0]["error"]["message"] = true;
+            filter["transaction_failures"][0]["error"]["error_code"] = true;
+            filter["transaction_failures"][0]["error"]["vm_error_code"] = true;
+            break;
+        case APTOS_FILTER_RESOURCE_TYPES:
+            filter[0]["type"] = true;
+            return; // Array responses carry no error fields
+        case APTOS_FILTER_COIN_VALUE:
+            filter["data"]["coin"]["value"] = true;
+            break;
+        default:
+            return;
     }
-    
-    // Check if all characters are hex
-    for (int i = 0; i < addr.length(); i++) {
-        char c = addr.charAt(i);
-        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
-            return false;
+    addErrorFields(filter);
+}
+
+// Built on first use and shared by all SDK instances
+struct ResponseFilterTable {
+    JsonDocument filters[APTOS_FILTER_COUNT];
+
+    ResponseFilterTable() {
+        for (int i = 0; i < APTOS_FILTER_COUNT; i++) {
+            buildResponseFilter((AptosResponseFilter)i, filters[i]);
         }
     }
-    
-    return true;
+};
+
+const JsonDocument* AptosSDK::responseFilter(AptosResponseFilter preset) {
+    static const ResponseFilterTable table;
+    if (preset < 0 || preset >= APTOS_FILTER_COUNT) {
+        return nullptr;
+    }
+    return &table.filters[preset];
+}
+
+bool AptosSDK::isValidAddress(const String& address) {
+    // 1-64 hex digits, with or without 0x
+    return AccountAddress::isValid(address);
 }
 
 String AptosSDK::normalizeAddress(const String& address) {
-    String addr = address;
-    
-    // Remove 0x prefix if present
-    if (addr.startsWith("0x") || addr.startsWith("0X")) {
-        addr = addr.substring(2);
+    AccountAddress parsed;
+    if (parsed.parse(address)) {
+        return parsed.toString();
     }
-    
-    // Convert to lowercase
-    addr.toLowerCase();
-    
-    // Pad with leading zeros to make it 64 characters
-    while (addr.length() < 64) {
-        addr = "0" + addr;
-    }
-    
-    return "0x" + addr;
+    // Not an address; padded and lowercased as before
+    return AptosUtils::padHexAddress(address);
 }
 
 bool AptosSDK::isConnected() {
     JsonDocument response;
-    return getNodeInfo(response);
+    return getLedgerInfo(response, responseFilter(APTOS_FILTER_LEDGER_INFO));
 }
 
 bool AptosSDK::ping() {
@@ -413,101 +1425,133 @@ bool AptosSDK::ping() {
 }
 
 bool AptosSDK::getChainId(uint8_t& chainId) {
-    JsonDocument response;
-    if (getLedgerInfo(response)) {
-        chainId = response["chain_id"].as<uint8_t>();
+    AptosChainMetadata metadata;
+    if (getChainMetadata(metadata) && metadata.chainId != 0) {
+        chainId = metadata.chainId;
         return true;
     }
-    return false;
+    if (!fetchLedgerInfo()) {
+        return false;
+    }
+    getChainMetadata(metadata);
+    chainId = metadata.chainId;
+    return true;
+}
+
+bool AptosSDK::getChainMetadata(AptosChainMetadata& metadata) const {
+    std::lock_guard<std::mutex> guard(metadataMutex);
+    metadata = chainMetadata;
+    return chainMetadata.chainId != 0 || chainMetadata.gasEstimate != 0;
+}
+
+bool AptosSDK::refreshChainMetadata() {
+    bool ledgerOk = fetchLedgerInfo();
+    uint64_t gasPrice;
+    bool gasOk = fetchGasPrice(gasPrice);
+    return ledgerOk && gasOk;
+}
+
+uint64_t AptosSDK::getChainTimestamp() const {
+    std::lock_guard<std::mutex> guard(metadataMutex);
+    if (chainMetadata.ledgerTimestampUsec == 0) {
+        return AptosUtils::getCurrentTimestamp();
+    }
+    return chainMetadata.ledgerTimestampUsec / 1000000 + (millis() - chainMetadata.ledgerUpdatedMs) / 1000;
 }
 
 bool AptosSDK::transferCoin(AptosAccount& sender, const String& recipient, 
                            uint64_t amount, uint64_t& txnHash,
                            const String& coinType) {
-    // Get sender's account info for sequence number
-    JsonDocument accountInfo;
-    if (!getAccount(sender.getAddress(), accountInfo)) {
-        logDebug("Failed to get sender account info");
+    AccountAddress parsed;
+    return parseAddress(recipient, parsed) && transferCoin(sender, parsed, amount, txnHash, coinType);
+}
+
+bool AptosSDK::transferCoin(AptosAccount& sender, const AccountAddress& recipient, 
+                           uint64_t amount, uint64_t& txnHash,
+                           const String& coinType) {
+    JsonDocument response;
+    if (!submitCoinTransfer(sender, recipient, amount, coinType, response)) {
         return false;
     }
     
-    uint64_t sequenceNumber = AptosUtils::getJsonUint64(accountInfo, "sequence_number", 0);
-    
-    // Create transaction
-    AptosTransaction txn = AptosTransaction::createCoinTransfer(
-        sender.getAddress(), recipient, amount, sequenceNumber
-    );
-    
-    if (!txn.build()) {
-        logDebug("Failed to build transaction: " + txn.getError());
+    // Extract transaction hash
+    String hashStr = AptosUtils::getJsonString(response, "hash", "");
+    if (hashStr.isEmpty()) {
+        logDebug("No transaction hash in response");
         return false;
     }
     
-    // Sign transaction
-    String signedTxn;
-    if (!sender.signTransaction(txn.getTransaction(), signedTxn)) {
-        logDebug("Failed to sign transaction");
+    txnHash = strtoull(hashStr.c_str(), nullptr, 16);
+    return true;
+}
+
+bool AptosSDK::submitCoinTransfer(AptosAccount& sender, const AccountAddress& recipient,
+                                  uint64_t amount, const String& coinType, JsonDocument& response) {
+    // Next sequence number for the sender, from the local allocator when known
+    const AccountAddress& senderAddress = sender.getAccountAddress();
+    uint64_t sequenceNumber;
+    if (!nextSequenceNumber(senderAddress, sequenceNumber)) {
         return false;
     }
     
-    // Submit transaction
-    JsonDocument signedDoc;
-    if (!AptosUtils::parseJsonSafely(signedTxn, signedDoc)) {
-        logDebug("Failed to parse signed transaction");
-        return false;
-    }
+    // Create transaction
+    AptosTransaction txn;
+    txn.setSender(senderAddress)
+       .setSequenceNumber(sequenceNumber)
+       .setMaxGasAmount(AptosTransaction::DEFAULT_MAX_GAS)
+       .setGasUnitPrice(gasUnitPrice())
+       .coinTransfer(recipient, amount, coinType);
+    txn.setExpirationTimestamp(getChainTimestamp() + AptosTransaction::DEFAULT_EXPIRATION_OFFSET);
     
-    JsonDocument response;
-    if (!submitTransaction(signedDoc, response)) {
-        logDebug("Failed to submit transaction");
+    if (!txn.build()) {
+        logDebug("Failed to build transaction: " + txn.getError());
+        sequenceNumbers.release(senderAddress, sequenceNumber);
         return false;
     }
     
-    // Extract transaction hash
-    String hashStr = AptosUtils::getJsonString(response, "hash", "");
-    if (hashStr.isEmpty()) {
-        logDebug("No transaction hash in response");
+    // Sign and submit transaction
+    if (!signAndSubmit(sender, txn, response)) {
+        logDebug("Failed to submit transaction");
         return false;
     }
-    
-    txnHash = strtoull(hashStr.c_str(), nullptr, 16);
     return true;
 }
 
 bool AptosSDK::transferToken(AptosAccount& sender, const String& recipient,
                             const String& creator, const String& collection,
                             const String& tokenName, uint64_t amount, uint64_t& txnHash) {
-    // Get sender's account info for sequence number
-    JsonDocument accountInfo;
-    if (!getAccount(sender.getAddress(), accountInfo)) {
+    AccountAddress recipientAddress;
+    AccountAddress creatorAddress;
+    return parseAddress(recipient, recipientAddress) && parseAddress(creator, creatorAddress) &&
+           transferToken(sender, recipientAddress, creatorAddress, collection, tokenName, amount, txnHash);
+}
+
+bool AptosSDK::transferToken(AptosAccount& sender, const AccountAddress& recipient,
+                            const AccountAddress& creator, const String& collection,
+                            const String& tokenName, uint64_t amount, uint64_t& txnHash) {
+    // Next sequence number for the sender, from the local allocator when known
+    const AccountAddress& senderAddress = sender.getAccountAddress();
+    uint64_t sequenceNumber;
+    if (!nextSequenceNumber(senderAddress, sequenceNumber)) {
         return false;
     }
     
-    uint64_t sequenceNumber = AptosUtils::getJsonUint64(accountInfo, "sequence_number", 0);
-    
     // Create token transfer transaction
     AptosTransaction txn;
-    txn.setSender(sender.getAddress())
+    txn.setSender(sender.getAccountAddress())
        .setSequenceNumber(sequenceNumber)
+       .setGasUnitPrice(gasUnitPrice())
+       .setExpirationTimestamp(getChainTimestamp() + AptosTransaction::DEFAULT_EXPIRATION_OFFSET)
        .tokenTransfer(recipient, creator, collection, tokenName, amount);
     
     if (!txn.build()) {
+        sequenceNumbers.release(senderAddress, sequenceNumber);
         return false;
     }
     
     // Sign and submit
-    String signedTxn;
-    if (!sender.signTransaction(txn.getTransaction(), signedTxn)) {
-        return false;
-    }
-    
-    JsonDocument signedDoc;
-    if (!AptosUtils::parseJsonSafely(signedTxn, signedDoc)) {
-        return false;
-    }
-    
     JsonDocument response;
-    if (!submitTransaction(signedDoc, response)) {
+    if (!signAndSubmit(sender, txn, response)) {
         return false;
     }
     
@@ -524,43 +1568,50 @@ bool AptosSDK::callFunction(AptosAccount& sender, const String& moduleAddress,
                            const String& moduleName, const String& functionName,
                            const JsonArray& typeArgs, const JsonArray& args,
                            JsonDocument& response) {
-    // Get sender's account info for sequence number
-    JsonDocument accountInfo;
-    if (!getAccount(sender.getAddress(), accountInfo)) {
+    // Next sequence number for the sender, from the local allocator when known
+    const AccountAddress& senderAddress = sender.getAccountAddress();
+    uint64_t sequenceNumber;
+    if (!nextSequenceNumber(senderAddress, sequenceNumber)) {
         return false;
     }
     
-    uint64_t sequenceNumber = AptosUtils::getJsonUint64(accountInfo, "sequence_number", 0);
-    
     // Create function call transaction
     AptosTransaction txn;
-    txn.setSender(sender.getAddress())
+    txn.setSender(sender.getAccountAddress())
        .setSequenceNumber(sequenceNumber)
+       .setGasUnitPrice(gasUnitPrice())
+       .setExpirationTimestamp(getChainTimestamp() + AptosTransaction::DEFAULT_EXPIRATION_OFFSET)
        .entryFunction(moduleAddress, moduleName, functionName, typeArgs, args);
     
     if (!txn.build()) {
+        sequenceNumbers.release(senderAddress, sequenceNumber);
         return false;
     }
     
     // Sign and submit
-    String signedTxn;
-    if (!sender.signTransaction(txn.getTransaction(), signedTxn)) {
-        return false;
-    }
-    
-    JsonDocument signedDoc;
-    if (!AptosUtils::parseJsonSafely(signedTxn, signedDoc)) {
-        return false;
-    }
-    
-    return submitTransaction(signedDoc, response);
+    return signAndSubmit(sender, txn, response);
+}
+
+bool AptosSDK::callFunction(AptosAccount& sender, const AccountAddress& moduleAddress,
+                           const String& moduleName, const String& functionName,
+                           const JsonArray& typeArgs, const JsonArray& args,
+                           JsonDocument& response) {
+    return callFunction(sender, moduleAddress.toString(), moduleName, functionName, typeArgs, args, response);
 }
 
 bool AptosSDK::getEventsByCreationNumber(const String& address, uint64_t creationNumber,
-                                        JsonDocument& response, int limit) {
-    String normalizedAddr = normalizeAddress(address);
-    String endpoint = "accounts/" + normalizedAddr + "/events/" + String((unsigned long)creationNumber) + 
+                                        JsonDocument& response, int limit, uint64_t start) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getEventsByCreationNumber(parsed, creationNumber, response, limit, start);
+}
+
+bool AptosSDK::getEventsByCreationNumber(const AccountAddress& address, uint64_t creationNumber,
+                                        JsonDocument& response, int limit, uint64_t start) {
+    String endpoint = accountEndpoint(address) + "/events/" + AptosUtils::toDecimalString(creationNumber) + 
                      "?limit=" + String(limit);
+    if (start != APTOS_EVENTS_LATEST) {
+        endpoint += "&start=" + AptosUtils::toDecimalString(start);
+    }
     return makeHttpRequest(endpoint, response, "GET");
 }
 
@@ -576,16 +1627,20 @@ bool AptosSDK::estimateTransactionGas(const JsonDocument& transaction, uint64_t&
 }
 
 String AptosSDK::getLastError() {
-    // Return the last HTTP error or other error
-    return "HTTP Error Code: " + String(http.errorToString(http.getLastError()).c_str());
+    // Negative codes are transport errors reported by HTTPClient
+    int httpCode = lastHttpCode;
+    if (httpCode < 0) {
+        return "HTTP Error: " + HTTPClient::errorToString(httpCode);
+    }
+    return "HTTP Error Code: " + String(httpCode);
 }
 
 bool AptosSDK::getEventsByEventKey(const String& eventKey, JsonDocument& response,
-                                  int limit, int start) {
+                                  int limit, uint64_t start) {
     String endpoint = "events/" + eventKey;
     String params = "limit=" + String(limit);
-    if (start > 0) {
-        params += "&start=" + String(start);
+    if (start != APTOS_EVENTS_LATEST) {
+        params += "&start=" + AptosUtils::toDecimalString(start);
     }
     endpoint += "?" + params;
     return makeHttpRequest(endpoint, response, "GET");
@@ -595,19 +1650,19 @@ bool AptosSDK::getTableItem(const String& tableHandle, const JsonDocument& table
                            JsonDocument& response, uint64_t ledgerVersion) {
     String endpoint = "tables/" + tableHandle + "/item";
     if (ledgerVersion > 0) {
-        endpoint += "?ledger_version=" + String((unsigned long)ledgerVersion);
+        endpoint += "?ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     
     String payload;
     serializeJson(tableItemRequest, payload);
-    return makeHttpRequest(endpoint, response, "POST", payload);
+    return cachedRequest(endpoint, response, "POST", payload, ledgerVersion > 0);
 }
 
 bool AptosSDK::getRawTableItem(const String& tableHandle, const JsonDocument& tableItemRequest,
                               JsonDocument& response, uint64_t ledgerVersion) {
     String endpoint = "tables/" + tableHandle + "/raw_item";
     if (ledgerVersion > 0) {
-        endpoint += "?ledger_version=" + String((unsigned long)ledgerVersion);
+        endpoint += "?ledger_version=" + AptosUtils::toDecimalString(ledgerVersion);
     }
     
     String payload;
@@ -628,20 +1683,24 @@ bool AptosSDK::getOpenApiSpec(JsonDocument& response) {
 }
 
 bool AptosSDK::getAccountBalanceSimple(const String& address, uint64_t& balance, const String& coinType) {
+    AccountAddress parsed;
+    return parseAddress(address, parsed) && getAccountBalanceSimple(parsed, balance, coinType);
+}
+
+bool AptosSDK::getAccountBalanceSimple(const AccountAddress& address, uint64_t& balance, const String& coinType) {
+    // Fetch only the CoinStore, and only its value, rather than every resource
     JsonDocument response;
-    if (!getAccountResources(address, response)) {
+    if (!getAccountResource(address, "0x1::coin::CoinStore<" + coinType + ">", response, 0,
+                            responseFilter(APTOS_FILTER_COIN_VALUE))) {
         return false;
     }
     
-    // Find coin store resource
-    for (JsonVariant resource : response.as<JsonArray>()) {
-        String resourceType = resource["type"].as<String>();
-        if (resourceType.indexOf("0x1::coin::CoinStore<" + coinType + ">") != -1) {
-            balance = resource["data"]["coin"]["value"].as<uint64_t>();
-            return true;
-        }
+    JsonVariant value = response["data"]["coin"]["value"];
+    if (value.isNull()) {
+        balance = 0;
+        return false;
     }
     
-    balance = 0;
-    return false;
+    balance = value.as<uint64_t>();
+    return true;
 }
@@ -13,6 +13,14 @@
 #include "AptosAccount.h"
 #include "AptosTransaction.h"
 #include "AptosUtils.h"
+#include "AptosHttpStream.h"
+#include "AptosSequenceManager.h"
+#include "AptosResponseCache.h"
+#include "AptosNodePool.h"
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 // Network endpoints
 #define APTOS_MAINNET "https://api.mainnet.aptoslabs.com/v1"
@@ -32,18 +40,243 @@ enum AptosError
     APTOS_ERROR_TIMEOUT = -7
 };
 
+// Wire format used by the transfer and contract helpers
+enum AptosSubmitMode
+{
+    APTOS_SUBMIT_JSON,
+    APTOS_SUBMIT_BCS
+};
+
+// Largest response body parsed by default; 0 disables the limit
+#ifndef APTOS_DEFAULT_MAX_RESPONSE_SIZE
+#define APTOS_DEFAULT_MAX_RESPONSE_SIZE 65536
+#endif
+
+// Built-in response filters, see AptosSDK::responseFilter(). Fields outside
+// the filter are dropped while parsing instead of being materialized.
+enum AptosResponseFilter
+{
+    APTOS_FILTER_LEDGER_INFO,         // chain_id, epoch, ledger_version, ...
+    APTOS_FILTER_ACCOUNT,             // sequence_number, authentication_key
+    APTOS_FILTER_GAS_ESTIMATE,        // gas_estimate and its bounds
+    APTOS_FILTER_TRANSACTION_STATUS,  // hash, sender, version, success, vm_status, type
+    APTOS_FILTER_RESOURCE_TYPES,      // [{ type }]
+    APTOS_FILTER_COIN_VALUE,          // data.coin.value of a CoinStore
+    APTOS_FILTER_TRANSACTION_LIST,    // [{ hash, version, success, vm_status, ... }]
+    APTOS_FILTER_BATCH_FAILURES,      // transaction_failures[{ transaction_index, error }]
+    APTOS_FILTER_COUNT
+};
+
+// Where a transaction stands once a wait ends
+enum AptosTransactionStatus
+{
+    APTOS_TXN_SUCCESS,   // Committed and executed
+    APTOS_TXN_FAILED,    // Committed, but the VM aborted it (see vm_status)
+    APTOS_TXN_PENDING,   // Still in mempool when the wait timed out
+    APTOS_TXN_NOT_FOUND, // Unknown to the node (never arrived, expired or dropped)
+    APTOS_TXN_ERROR      // No usable answer from the node
+};
+
+// Poll schedule used when the node has no wait_by_hash endpoint, and for
+// waits by version: the delay starts small and grows by half each round
+#ifndef APTOS_WAIT_POLL_INITIAL_MS
+#define APTOS_WAIT_POLL_INITIAL_MS 100
+#endif
+#ifndef APTOS_WAIT_POLL_MAX_MS
+#define APTOS_WAIT_POLL_MAX_MS 1000
+#endif
+
+// How long a gas estimate is reused before estimateGasPrice() asks again
+#ifndef APTOS_GAS_PRICE_TTL_MS
+#define APTOS_GAS_PRICE_TTL_MS 30000
+#endif
+
+// What the SDK last learned about the chain. The ledger fields are taken
+// from the X-Aptos-* headers of every response, so they are as fresh as
+// the last request; the chain id never changes for a node URL.
+struct AptosChainMetadata
+{
+    uint8_t chainId;                   // 0 until known
+    uint64_t ledgerVersion;
+    uint64_t ledgerTimestampUsec;
+    unsigned long ledgerUpdatedMs;     // millis() when the ledger fields were seen
+    uint64_t gasEstimate;              // 0 until estimated
+    uint64_t prioritizedGasEstimate;
+    uint64_t deprioritizedGasEstimate;
+    unsigned long gasUpdatedMs;        // millis() of the last estimate
+};
+
+// HTTP connections per AptosSDK. A hedged read uses two at once, and the
+// slower one keeps its connection until its node answers, so a third lets
+// the next read be hedged meanwhile. Only open connections cost memory.
+#ifndef APTOS_HTTP_CHANNELS
+#define APTOS_HTTP_CHANNELS 3
+#endif
+
+// Hedged reads (setHedging): the second request goes out once the first
+// has taken longer than this percentile of its node's recent latency, or
+// after the default delay while the node has too few samples
+#define APTOS_HEDGE_DEFAULT_PERCENTILE 95
+#define APTOS_HEDGE_DEFAULT_DELAY_MS 300
+#define APTOS_HEDGE_MIN_DELAY_MS 10
+
+// Stack of the threads that run hedged attempts (ESP32)
+#ifndef APTOS_HEDGE_STACK_SIZE
+#define APTOS_HEDGE_STACK_SIZE 8192
+#endif
+
+struct AptosHedgeStats
+{
+    uint32_t requests; // Reads sent hedged
+    uint32_t fired;    // A second request went out
+    uint32_t won;      // ... and answered first
+};
+
+// Identical reads in flight at the same time that later callers can
+// attach to (setCoalescing); further ones are simply sent
+#ifndef APTOS_COALESCE_MAX_READS
+#define APTOS_COALESCE_MAX_READS 8
+#endif
+
+struct AptosCoalesceStats
+{
+    uint32_t requests;  // Reads that could be shared
+    uint32_t coalesced; // ... answered by another caller's request
+};
+
+// Outcome of one transaction of a batch submission
+struct AptosBatchResult
+{
+    bool accepted;    // Taken into mempool
+    int vmErrorCode;  // vm_error_code, 0 when the node gave none
+    String errorCode; // error_code such as "vm_error", empty when accepted
+    String message;   // The node's explanation, e.g. the validation status
+};
+
+// vm_error_code values the SDK reacts to
+#define APTOS_VM_SEQUENCE_NUMBER_TOO_OLD 3
+#define APTOS_VM_SEQUENCE_NUMBER_TOO_NEW 4
+
+// start argument of the event getters asking for the most recent events;
+// any other value (0 included) is sent as the first sequence number wanted
+#define APTOS_EVENTS_LATEST UINT64_MAX
+
+#define APTOS_CONTENT_TYPE_JSON "application/json"
+#define APTOS_CONTENT_TYPE_SIGNED_TXN_BCS "application/x.aptos.signed_transaction+bcs"
+
+class AptosPipeline;
+class AptosAsync;
+class AptosPageIterator;
+class AptosEventFollower;
+
 class AptosSDK
 {
+    // Shares the sequence number allocator and the submit helpers
+    friend class AptosPipeline;
+    // Reaches makeHttpRequest and the submit helpers from its worker
+    friend class AptosAsync;
+    // Needs the X-Aptos-Cursor of each page
+    friend class AptosPageIterator;
+
 private:
-    String nodeUrl;
-    HTTPClient http;
-    int timeout;
+    // One HTTP connection and the hedged attempt running on it, if any
+    struct HttpChannel
+    {
+        HTTPClient client;
+        int node; // Node the kept-alive connection belongs to
+        std::thread worker;
+        std::atomic<bool> busy;
+    };
+    struct HttpRequest
+    {
+        const String *endpoint;
+        const String *method;
+        const uint8_t *body;
+        Stream *requestBody;
+        size_t bodyLength;
+        const char *contentType;
+        String *cursor; // Receives X-Aptos-Cursor, nullptr if not wanted
+        int *status;    // Receives this request's HTTP code, nullptr if not wanted
+    };
+    struct HedgedRead;
+    struct SharedRead;
+
+    AptosNodePool nodes;
+    HttpChannel channels[APTOS_HTTP_CHANNELS];
+    std::atomic<int> timeout;       // Applied by exchange() on the channel's own thread
     bool debugMode;
+    AptosSubmitMode submitMode;
+    size_t maxResponseSize;
+    std::atomic<int> lastHttpCode;  // Any task's latest, for getLastError() only
+    bool waitByHashAvailable;
+    bool localSequenceNumbers;
+    AptosSequenceManager sequenceNumbers;
+    AptosResponseCache responseCache;
+    AptosChainMetadata chainMetadata;
+    uint32_t gasPriceTtlMs;
+    mutable std::mutex metadataMutex;
+    bool hedging;
+    uint8_t hedgePercentile;
+    std::atomic<uint32_t> hedgeRequests;
+    std::atomic<uint32_t> hedgesFired;
+    std::atomic<uint32_t> hedgesWon;
+    bool coalescing;
+    uint32_t writeGeneration;
+    std::shared_ptr<SharedRead> sharedReads[APTOS_COALESCE_MAX_READS];
+    std::atomic<uint32_t> coalesceRequests;
+    std::atomic<uint32_t> coalescedReads;
+    std::mutex sharedMutex;
+    std::mutex httpMutex;
 
     // Internal helper methods
+    // status receives the HTTP code of this very request; lastHttpCode may
+    // already belong to another task's by the time the call returns
     bool makeHttpRequest(const String &endpoint, JsonDocument &response,
-                         const String &method = "GET", const String &payload = "");
-    String formatUrl(const String &endpoint);
+                         const String &method = "GET", const String &payload = "",
+                         const JsonDocument *filter = nullptr, int *status = nullptr);
+    bool makeHttpRequest(const String &endpoint, JsonDocument &response, const String &method,
+                         const uint8_t *body, size_t bodyLength, const char *contentType,
+                         const JsonDocument *filter = nullptr, int *status = nullptr);
+    bool makeHttpRequest(const String &endpoint, JsonDocument &response, Stream &body,
+                         size_t bodyLength, const char *contentType,
+                         const JsonDocument *filter = nullptr, int *status = nullptr);
+    bool sendHttpRequest(const String &endpoint, JsonDocument &response, const String &method,
+                         const uint8_t *body, Stream *requestBody, size_t bodyLength,
+                         const char *contentType, const JsonDocument *filter, String *cursor = nullptr,
+                         int *status = nullptr);
+    bool fetchPage(const String &endpoint, JsonDocument &response, String &cursor,
+                   const JsonDocument *filter = nullptr);
+    bool routeHttpRequest(const HttpRequest &request, JsonDocument &response, const JsonDocument *filter);
+    static bool readOnlyRequest(const String &endpoint, const String &method);
+    static bool nodeFailure(int httpCode);
+    HttpChannel &idleChannel();
+    int exchange(HttpChannel &channel, int node, const HttpRequest &request);
+    bool readResponse(HttpChannel &channel, int httpCode, JsonDocument &response,
+                      const JsonDocument *filter, String *cursor = nullptr);
+    bool hedgedRequest(const HttpRequest &request, const JsonDocument *filter,
+                       JsonDocument &response, bool &parsed);
+    void startAttempt(std::shared_ptr<HedgedRead> read, int attempt, HttpChannel &channel, int node);
+    uint32_t hedgeDelay(int node);
+    bool cachedRequest(const String &endpoint, JsonDocument &response, const String &method,
+                       const String &payload, bool pinned, const JsonDocument *filter = nullptr);
+    bool signAndSubmit(AptosAccount &sender, AptosTransaction &txn, JsonDocument &response);
+    bool submitCoinTransfer(AptosAccount &sender, const AccountAddress &recipient, uint64_t amount,
+                            const String &coinType, JsonDocument &response);
+    bool submitSigned(AptosAccount &sender, AptosTransaction &txn, JsonDocument &response, bool &posted);
+    bool postTransactionBCS(const uint8_t *signedTxn, size_t length, JsonDocument &response, int *status);
+    bool fetchSequenceNumber(const AccountAddress &address, uint64_t &sequenceNumber);
+    bool nextSequenceNumber(const AccountAddress &address, uint64_t &sequenceNumber);
+    static int sequenceNumberError(const JsonDocument &response);
+    bool cachedChainId(uint8_t &chainId);
+    void recordLedgerInfo(uint8_t chainId, uint64_t ledgerVersion, uint64_t ledgerTimestampUsec);
+    bool fetchLedgerInfo();
+    bool fetchGasPrice(uint64_t &gasPrice);
+    uint64_t gasUnitPrice();
+    AptosTransactionStatus waitForCommit(const String &txnHash, uint64_t version, JsonDocument &transaction,
+                                         uint32_t timeoutMs, const JsonDocument *filter);
+    String formatUrl(int node, const String &endpoint);
+    bool parseAddress(const String &address, AccountAddress &parsed);
+    static String accountEndpoint(const AccountAddress &address);
     void logDebug(const String &message);
 
 public:
@@ -53,66 +286,150 @@ public:
 
     // Configuration
     void setNodeUrl(const String &url);
+    // Extra fullnodes (up to APTOS_NODE_MAX in total, all on the same
+    // chain). Reads go to the fastest healthy node and fail over to the
+    // next; submissions stick to one node.
+    bool addNode(const String &url);
+    size_t getNodeCount() const;
+    bool getNodeStats(size_t index, AptosNodeStats &stats) const;
+    // Reads (not submissions) are also sent to a second node when the
+    // first has not answered within the given percentile of its recent
+    // latency; the first good answer is used. Needs two or more nodes.
+    void setHedging(bool enabled, uint8_t percentile = APTOS_HEDGE_DEFAULT_PERCENTILE);
+    AptosHedgeStats getHedgeStats() const;
+    // A read issued while an identical one (same endpoint, body and
+    // filter) is in flight waits for that request and gets a copy of its
+    // result instead of sending its own. Never across a submission, so a
+    // read after a write still sees it. On by default.
+    void setCoalescing(bool enabled);
+    AptosCoalesceStats getCoalesceStats() const;
     void setTimeout(int timeoutMs);
     void setDebugMode(bool enabled);
+    void setSubmitMode(AptosSubmitMode mode);
+    void setMaxResponseSize(size_t maxBytes);
+    void setLocalSequenceNumbers(bool enabled);
+    void resetSequenceNumbers(const String &address = "");
+    void resetSequenceNumbers(const AccountAddress &address);
+
+    // Read cache for getAccountResource, getAccountModule, viewFunction and
+    // getTableItem; off until setCacheSize() is called. Reads at a pinned
+    // ledger version are kept until evicted, reads at the latest version
+    // for ttlMs.
+    void setCacheSize(size_t maxEntries, size_t maxBytes = APTOS_CACHE_DEFAULT_MAX_BYTES);
+    void setCacheTtl(uint32_t ttlMs);
+    void clearCache();
+    AptosCacheStats getCacheStats() const;
 
     // Node Information
     bool getNodeInfo(JsonDocument &response);
-    bool getLedgerInfo(JsonDocument &response);
+    bool getLedgerInfo(JsonDocument &response, const JsonDocument *filter = nullptr);
     bool getBlockByHeight(uint64_t height, JsonDocument &response);
     bool getBlockByVersion(uint64_t version, JsonDocument &response);
 
-    // Account Operations
-    bool getAccount(const String &address, JsonDocument &response, uint64_t ledgerVersion = 0);
+    // Account Operations. Every address argument can be given as a hex
+    // String ("0x1", checked and normalized on each call) or as an
+    // AccountAddress parsed once up front.
+    bool getAccount(const String &address, JsonDocument &response, uint64_t ledgerVersion = 0,
+                    const JsonDocument *filter = nullptr);
+    bool getAccount(const AccountAddress &address, JsonDocument &response, uint64_t ledgerVersion = 0,
+                    const JsonDocument *filter = nullptr);
     bool getAccountBalance(const String &address, const String &assetType, JsonDocument &response, uint64_t ledgerVersion = 0);
+    bool getAccountBalance(const AccountAddress &address, const String &assetType, JsonDocument &response, uint64_t ledgerVersion = 0);
     bool getAccountResources(const String &address, JsonDocument &response,
-                             uint64_t ledgerVersion = 0, const String &start = "", int limit = 0);
+                             uint64_t ledgerVersion = 0, const String &start = "", int limit = 0,
+                             const JsonDocument *filter = nullptr);
+    bool getAccountResources(const AccountAddress &address, JsonDocument &response,
+                             uint64_t ledgerVersion = 0, const String &start = "", int limit = 0,
+                             const JsonDocument *filter = nullptr);
     bool getAccountResource(const String &address, const String &resourceType,
-                            JsonDocument &response, uint64_t ledgerVersion = 0);
+                            JsonDocument &response, uint64_t ledgerVersion = 0,
+                            const JsonDocument *filter = nullptr);
+    bool getAccountResource(const AccountAddress &address, const String &resourceType,
+                            JsonDocument &response, uint64_t ledgerVersion = 0,
+                            const JsonDocument *filter = nullptr);
     bool getAccountModules(const String &address, JsonDocument &response,
                            uint64_t ledgerVersion = 0, const String &start = "", int limit = 0);
+    bool getAccountModules(const AccountAddress &address, JsonDocument &response,
+                           uint64_t ledgerVersion = 0, const String &start = "", int limit = 0);
     bool getAccountModule(const String &address, const String &moduleName,
                           JsonDocument &response, uint64_t ledgerVersion = 0);
+    bool getAccountModule(const AccountAddress &address, const String &moduleName,
+                          JsonDocument &response, uint64_t ledgerVersion = 0);
     bool getAccountTransactions(const String &address, JsonDocument &response,
-                                int limit = 25, int start = 0);
+                                int limit = 25, int start = 0, const JsonDocument *filter = nullptr);
+    bool getAccountTransactions(const AccountAddress &address, JsonDocument &response,
+                                int limit = 25, int start = 0, const JsonDocument *filter = nullptr);
     bool getAccountEvents(const String &address, const String &eventHandle,
-                          JsonDocument &response, int limit = 25, int start = 0);
+                          JsonDocument &response, int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
+    bool getAccountEvents(const AccountAddress &address, const String &eventHandle,
+                          JsonDocument &response, int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
 
     // Transaction Operations
-    bool getTransactionByHash(const String &txnHash, JsonDocument &response);
-    bool getTransactionByVersion(uint64_t version, JsonDocument &response);
-    bool getTransactions(JsonDocument &response, int limit = 25, int start = 0);
+    bool getTransactionByHash(const String &txnHash, JsonDocument &response,
+                              const JsonDocument *filter = nullptr);
+    bool getTransactionByVersion(uint64_t version, JsonDocument &response,
+                                 const JsonDocument *filter = nullptr);
+    bool getTransactions(JsonDocument &response, int limit = 25, int start = 0,
+                         const JsonDocument *filter = nullptr);
     bool submitTransaction(const JsonDocument &transaction, JsonDocument &response);
+    bool submitTransactionBCS(const uint8_t *signedTxn, size_t length, JsonDocument &response);
     bool simulateTransaction(const JsonDocument &transaction, JsonDocument &response,
                              bool estimateGas = false, bool estimateMaxGas = false);
     bool batchSubmitTransactions(const JsonArray &transactions, JsonDocument &response);
+    bool batchSubmitTransactionsBCS(const AptosBCSWriter *signedTxns, size_t count,
+                                    AptosBatchResult *results);
     bool waitForTransaction(const String &txnHash, int maxWaitTime = 30);
     bool waitForTransactionByVersion(uint64_t version, int maxWaitTime = 30);
+    // Waits for txnHash to leave mempool and returns the (filtered) final
+    // transaction. Long-polls wait_by_hash, or polls by_hash with a growing
+    // delay on nodes without it; a custom filter must keep type, success
+    // and error_code. The bool waiters above return false as soon as the
+    // transaction commits as failed.
+    AptosTransactionStatus waitForTransactionStatus(const String &txnHash, JsonDocument &transaction,
+                                                    uint32_t timeoutMs = 30000,
+                                                    const JsonDocument *filter = responseFilter(APTOS_FILTER_TRANSACTION_STATUS));
 
     // Transfer Operations
     bool transferCoin(AptosAccount &sender, const String &recipient,
                       uint64_t amount, uint64_t &txnHash,
                       const String &coinType = "0x1::aptos_coin::AptosCoin");
+    bool transferCoin(AptosAccount &sender, const AccountAddress &recipient,
+                      uint64_t amount, uint64_t &txnHash,
+                      const String &coinType = "0x1::aptos_coin::AptosCoin");
     bool transferToken(AptosAccount &sender, const String &recipient,
                        const String &creator, const String &collection,
                        const String &tokenName, uint64_t amount, uint64_t &txnHash);
+    bool transferToken(AptosAccount &sender, const AccountAddress &recipient,
+                       const AccountAddress &creator, const String &collection,
+                       const String &tokenName, uint64_t amount, uint64_t &txnHash);
 
     // Smart Contract Operations
     bool callFunction(AptosAccount &sender, const String &moduleAddress,
                       const String &moduleName, const String &functionName,
                       const JsonArray &typeArgs, const JsonArray &args,
                       JsonDocument &response);
+    bool callFunction(AptosAccount &sender, const AccountAddress &moduleAddress,
+                      const String &moduleName, const String &functionName,
+                      const JsonArray &typeArgs, const JsonArray &args,
+                      JsonDocument &response);
     bool viewFunction(const String &moduleAddress, const String &moduleName,
                       const String &functionName, const JsonArray &typeArgs,
                       const JsonArray &args, JsonDocument &response);
+    bool viewFunction(const AccountAddress &moduleAddress, const String &moduleName,
+                      const String &functionName, const JsonArray &typeArgs,
+                      const JsonArray &args, JsonDocument &response);
 
     // Event Operations
     bool getEventsByEventHandle(const String &address, const String &eventHandle,
-                                JsonDocument &response, int limit = 25, int start = 0);
+                                JsonDocument &response, int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
+    bool getEventsByEventHandle(const AccountAddress &address, const String &eventHandle,
+                                JsonDocument &response, int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
     bool getEventsByCreationNumber(const String &address, uint64_t creationNumber,
-                                   JsonDocument &response, int limit = 25, int start = 0);
+                                   JsonDocument &response, int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
+    bool getEventsByCreationNumber(const AccountAddress &address, uint64_t creationNumber,
+                                   JsonDocument &response, int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
     bool getEventsByEventKey(const String &eventKey, JsonDocument &response,
-                             int limit = 25, int start = 0);
+                             int limit = 25, uint64_t start = APTOS_EVENTS_LATEST);
 
     // Table Operations
     bool getTableItem(const String &tableHandle, const JsonDocument &tableItemRequest,
@@ -126,10 +443,18 @@ public:
     bool getOpenApiSpec(JsonDocument &response);
 
     // Gas and Fee Operations
+    // The estimate is reused for the gas price TTL; the transfer and
+    // contract helpers use it as their gas unit price
     bool estimateGasPrice(uint64_t &gasPrice);
+    void setGasPriceTtl(uint32_t ttlMs);
     bool estimateTransactionGas(const JsonDocument &transaction, uint64_t &gasUsed);
 
+    // Response filters: pass one of these (or any ArduinoJson filter
+    // document) as the filter argument of the getters above
+    static const JsonDocument *responseFilter(AptosResponseFilter preset);
+
     // Utility Methods
+    static AptosTransactionStatus transactionStatus(const JsonDocument &transaction);
     bool isValidAddress(const String &address);
     String normalizeAddress(const String &address);
     bool isConnected();
@@ -138,10 +463,23 @@ public:
     // Helper methods for backward compatibility
     bool getAccountBalanceSimple(const String &address, uint64_t &balance,
                                  const String &coinType = "0x1::aptos_coin::AptosCoin");
+    bool getAccountBalanceSimple(const AccountAddress &address, uint64_t &balance,
+                                 const String &coinType = "0x1::aptos_coin::AptosCoin");
 
     // Network status
     bool ping();
     bool getChainId(uint8_t &chainId);
+
+    // Chain metadata: getChainMetadata() returns what is known without a
+    // request (false if nothing yet). refreshChainMetadata() fetches the
+    // ledger info and a new gas estimate; call it from loop() or a
+    // background task to keep transaction building off the network.
+    bool getChainMetadata(AptosChainMetadata &metadata) const;
+    bool refreshChainMetadata();
+
+    // Current time in seconds by the ledger clock, extrapolated from the
+    // last response; the local clock until the node has been heard from
+    uint64_t getChainTimestamp() const;
 };
 
 #endif
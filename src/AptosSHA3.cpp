@@ -0,0 +1,125 @@
+#include "AptosSHA3.h"
+
+// Keccak-f[1600] round constants
+static const uint64_t KECCAK_ROUND_CONSTANTS[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// Rho rotation amounts and pi lane order, following the lane visited at each step
+static const uint8_t KECCAK_ROTATIONS[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+
+static const uint8_t KECCAK_PI_LANES[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+
+// SHA3 domain padding (0b01 suffix followed by the first pad bit)
+#define SHA3_DOMAIN_PAD 0x06
+
+static inline uint64_t rotl64(uint64_t x, unsigned n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+static inline uint64_t loadLane(const uint8_t* p) {
+    uint64_t lane = 0;
+    for (int i = 7; i >= 0; i--) {
+        lane = (lane << 8) | p[i];
+    }
+    return lane;
+}
+
+AptosSHA3::AptosSHA3() {
+    reset();
+}
+
+void AptosSHA3::reset() {
+    memset(state, 0, sizeof(state));
+    position = 0;
+}
+
+void AptosSHA3::permute() {
+    uint64_t c[5];
+
+    for (int round = 0; round < 24; round++) {
+        // Theta
+        for (int x = 0; x < 5; x++) {
+            c[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+        }
+        for (int x = 0; x < 5; x++) {
+            uint64_t d = c[(x + 4) % 5] ^ rotl64(c[(x + 1) % 5], 1);
+            for (int y = 0; y < 25; y += 5) {
+                state[y + x] ^= d;
+            }
+        }
+
+        // Rho and pi
+        uint64_t carried = state[1];
+        for (int i = 0; i < 24; i++) {
+            int lane = KECCAK_PI_LANES[i];
+            uint64_t next = state[lane];
+            state[lane] = rotl64(carried, KECCAK_ROTATIONS[i]);
+            carried = next;
+        }
+
+        // Chi
+        for (int y = 0; y < 25; y += 5) {
+            for (int x = 0; x < 5; x++) {
+                c[x] = state[y + x];
+            }
+            for (int x = 0; x < 5; x++) {
+                state[y + x] = c[x] ^ (~c[(x + 1) % 5] & c[(x + 2) % 5]);
+            }
+        }
+
+        // Iota
+        state[0] ^= KECCAK_ROUND_CONSTANTS[round];
+    }
+}
+
+void AptosSHA3::update(const uint8_t* data, size_t length) {
+    while (length > 0) {
+        // Whole blocks are absorbed a lane at a time
+        if (position == 0 && length >= SHA3_256_RATE) {
+            for (int i = 0; i < SHA3_256_RATE / 8; i++) {
+                state[i] ^= loadLane(data + 8 * i);
+            }
+            permute();
+            data += SHA3_256_RATE;
+            length -= SHA3_256_RATE;
+            continue;
+        }
+
+        state[position >> 3] ^= (uint64_t)*data++ << ((position & 7) * 8);
+        length--;
+        if (++position == SHA3_256_RATE) {
+            permute();
+            position = 0;
+        }
+    }
+}
+
+void AptosSHA3::update(uint8_t value) {
+    update(&value, 1);
+}
+
+void AptosSHA3::finish(uint8_t* digest) {
+    state[position >> 3] ^= (uint64_t)SHA3_DOMAIN_PAD << ((position & 7) * 8);
+    state[(SHA3_256_RATE - 1) >> 3] ^= (uint64_t)0x80 << (((SHA3_256_RATE - 1) & 7) * 8);
+    permute();
+
+    for (int i = 0; i < SHA3_256_DIGEST_SIZE; i++) {
+        digest[i] = (uint8_t)(state[i >> 3] >> ((i & 7) * 8));
+    }
+}
+
+void AptosSHA3::hash(const uint8_t* data, size_t length, uint8_t* digest) {
+    AptosSHA3 hasher;
+    hasher.update(data, length);
+    hasher.finish(digest);
+}
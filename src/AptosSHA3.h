@@ -0,0 +1,36 @@
+#ifndef APTOS_SHA3_H
+#define APTOS_SHA3_H
+
+#include <Arduino.h>
+
+#define SHA3_256_DIGEST_SIZE 32
+#define SHA3_256_RATE 136
+
+// Streaming SHA3-256 (FIPS 202).
+//
+// Data can be fed in any number of update() calls, so BCS buffers and domain
+// prefixes are hashed in place instead of being concatenated first. The
+// object is a plain value: copying a hasher that has already absorbed a
+// fixed prefix is the cheap way to reuse that prefix.
+class AptosSHA3 {
+private:
+    uint64_t state[25];
+    size_t position;
+
+    void permute();
+
+public:
+    AptosSHA3();
+
+    void reset();
+    void update(const uint8_t* data, size_t length);
+    void update(uint8_t value);
+
+    // Writes the 32-byte digest. The hasher must be reset() before reuse.
+    void finish(uint8_t* digest);
+
+    // One-shot digest
+    static void hash(const uint8_t* data, size_t length, uint8_t* digest);
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "AptosSequenceManager.h"
+
+AptosSequenceManager::AptosSequenceManager() : useCounter(0) {
+    for (size_t i = 0; i < APTOS_SEQUENCE_MAX_ACCOUNTS; i++) {
+        entries[i].next = 0;
+        entries[i].lastUsed = 0;
+        entries[i].valid = false;
+    }
+}
+
+AptosSequenceManager::Entry* AptosSequenceManager::find(const AccountAddress& address) {
+    for (size_t i = 0; i < APTOS_SEQUENCE_MAX_ACCOUNTS; i++) {
+        if (entries[i].valid && entries[i].address == address) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+AptosSequenceManager::Entry* AptosSequenceManager::slotFor(const AccountAddress& address) {
+    Entry* entry = find(address);
+    if (entry != nullptr) {
+        return entry;
+    }
+
+    // Free slot first, otherwise the least recently used account
+    Entry* victim = &entries[0];
+    for (size_t i = 0; i < APTOS_SEQUENCE_MAX_ACCOUNTS; i++) {
+        if (!entries[i].valid) {
+            victim = &entries[i];
+            break;
+        }
+        if (entries[i].lastUsed < victim->lastUsed) {
+            victim = &entries[i];
+        }
+    }
+    victim->address = address;
+    victim->valid = false;
+    return victim;
+}
+
+bool AptosSequenceManager::allocate(const AccountAddress& address, uint64_t& sequenceNumber) {
+    std::lock_guard<std::mutex> guard(lock);
+    Entry* entry = find(address);
+    if (entry == nullptr) {
+        return false;
+    }
+    sequenceNumber = entry->next++;
+    entry->lastUsed = ++useCounter;
+    return true;
+}
+
+uint64_t AptosSequenceManager::seedAndAllocate(const AccountAddress& address, uint64_t onChainSequenceNumber) {
+    std::lock_guard<std::mutex> guard(lock);
+    Entry* entry = slotFor(address);
+    if (!entry->valid) {
+        entry->next = onChainSequenceNumber;
+        entry->valid = true;
+    }
+    entry->lastUsed = ++useCounter;
+    return entry->next++;
+}
+
+uint64_t AptosSequenceManager::advanceAndAllocate(const AccountAddress& address, uint64_t minimum) {
+    std::lock_guard<std::mutex> guard(lock);
+    Entry* entry = slotFor(address);
+    if (!entry->valid || entry->next < minimum) {
+        entry->next = minimum;
+        entry->valid = true;
+    }
+    entry->lastUsed = ++useCounter;
+    return entry->next++;
+}
+
+void AptosSequenceManager::release(const AccountAddress& address, uint64_t sequenceNumber) {
+    std::lock_guard<std::mutex> guard(lock);
+    Entry* entry = find(address);
+    if (entry == nullptr) {
+        return;
+    }
+    if (entry->next == sequenceNumber + 1) {
+        entry->next = sequenceNumber;
+    } else {
+        // Later numbers are already out; they would wait forever on the gap
+        entry->valid = false;
+    }
+}
+
+void AptosSequenceManager::rewind(const AccountAddress& address, uint64_t sequenceNumber) {
+    std::lock_guard<std::mutex> guard(lock);
+    Entry* entry = find(address);
+    if (entry != nullptr && entry->next > sequenceNumber) {
+        entry->next = sequenceNumber;
+    }
+}
+
+void AptosSequenceManager::invalidate(const AccountAddress& address) {
+    std::lock_guard<std::mutex> guard(lock);
+    Entry* entry = find(address);
+    if (entry != nullptr) {
+        entry->valid = false;
+    }
+}
+
+void AptosSequenceManager::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < APTOS_SEQUENCE_MAX_ACCOUNTS; i++) {
+        entries[i].valid = false;
+    }
+}
+
+bool AptosSequenceManager::peek(const AccountAddress& address, uint64_t& sequenceNumber) const {
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < APTOS_SEQUENCE_MAX_ACCOUNTS; i++) {
+        if (entries[i].valid && entries[i].address == address) {
+            sequenceNumber = entries[i].next;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,74 @@
+#ifndef APTOS_SEQUENCE_MANAGER_H
+#define APTOS_SEQUENCE_MANAGER_H
+
+#include <Arduino.h>
+#include <mutex>
+#include "AptosAddress.h"
+
+// Accounts whose next sequence number is tracked at the same time; the
+// least recently used one is dropped when a new account needs a slot
+#ifndef APTOS_SEQUENCE_MAX_ACCOUNTS
+#define APTOS_SEQUENCE_MAX_ACCOUNTS 4
+#endif
+
+// Re-syncs (and resubmissions) after a sequence number rejection
+#ifndef APTOS_SEQUENCE_MAX_RESYNCS
+#define APTOS_SEQUENCE_MAX_RESYNCS 3
+#endif
+
+// Hands out sequence numbers per sender without asking the node each time.
+//
+// The first number for an account is seeded from the node (getAccount);
+// after that numbers are allocated locally and consecutively. A rejection
+// that says the local view is wrong (SEQUENCE_NUMBER_TOO_OLD / TOO_NEW)
+// invalidates the account so the next allocation seeds again. A number that
+// never reached the mempool is given back with release().
+//
+// All methods are safe to call from several tasks.
+class AptosSequenceManager {
+private:
+    struct Entry {
+        AccountAddress address;
+        uint64_t next;
+        uint32_t lastUsed;
+        bool valid;
+    };
+
+    Entry entries[APTOS_SEQUENCE_MAX_ACCOUNTS];
+    uint32_t useCounter;
+    mutable std::mutex lock;
+
+    Entry* find(const AccountAddress& address);
+    Entry* slotFor(const AccountAddress& address);
+
+public:
+    AptosSequenceManager();
+
+    // Takes the next number for address; false if it has to be seeded first
+    bool allocate(const AccountAddress& address, uint64_t& sequenceNumber);
+
+    // Seeds address with the node's sequence number (unless another task
+    // already did) and takes the next number
+    uint64_t seedAndAllocate(const AccountAddress& address, uint64_t onChainSequenceNumber);
+
+    // Moves address to at least minimum (seeding it if unknown) and takes
+    // the next number; used when the node says a number is already taken
+    uint64_t advanceAndAllocate(const AccountAddress& address, uint64_t minimum);
+
+    // Returns a number that was never accepted by the node. Only the most
+    // recent allocation can be rewound; otherwise the account re-syncs.
+    void release(const AccountAddress& address, uint64_t sequenceNumber);
+
+    // Moves address back so sequenceNumber is handed out next; used when a
+    // transaction expired and left a gap in front of later ones
+    void rewind(const AccountAddress& address, uint64_t sequenceNumber);
+
+    // Forgets address; the next allocation asks the node again
+    void invalidate(const AccountAddress& address);
+    void clear();
+
+    // Next number that would be handed out, if known
+    bool peek(const AccountAddress& address, uint64_t& sequenceNumber) const;
+};
+
+#endif
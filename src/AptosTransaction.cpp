@@ -1,10 +1,33 @@
 #include "AptosTransaction.h"
 
-AptosTransaction::AptosTransaction() : isBuilt(false) {
+// BCS enum variant index of Transaction::UserTransaction (the payload and
+// type tag variants are in AptosMoveDescriptors.h)
+#define TRANSACTION_VARIANT_USER 0
+
+const uint8_t AptosTransaction::RAW_TRANSACTION_PREFIX[32] = {
+    0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e, 0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
+    0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e, 0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93
+};
+
+const uint8_t AptosTransaction::TRANSACTION_PREFIX[32] = {
+    0xfa, 0x21, 0x0a, 0x94, 0x17, 0xef, 0x3e, 0x7f, 0xa4, 0x5b, 0xfa, 0x1d, 0x17, 0xa8, 0xdb, 0xd4,
+    0xd8, 0x83, 0x71, 0x19, 0x10, 0xa5, 0x50, 0xd2, 0x65, 0xfe, 0xe1, 0x89, 0xe9, 0x26, 0x6d, 0xd4
+};
+
+// Hasher state with the transaction prefix and UserTransaction tag absorbed
+static AptosSHA3 makeUserTransactionHasher() {
+    AptosSHA3 hasher;
+    hasher.update(AptosTransaction::TRANSACTION_PREFIX, sizeof(AptosTransaction::TRANSACTION_PREFIX));
+    hasher.update((uint8_t)TRANSACTION_VARIANT_USER);
+    return hasher;
+}
+
+AptosTransaction::AptosTransaction() : payloadBcs(0), hasBcsPayload(false), chainId(0), isBuilt(false) {
     transaction.clear();
 }
 
-AptosTransaction::AptosTransaction(const JsonDocument& txn) : isBuilt(true) {
+AptosTransaction::AptosTransaction(const JsonDocument& txn)
+    : payloadBcs(0), hasBcsPayload(false), chainId(0), isBuilt(true) {
     transaction.set(txn);
 }
 
@@ -17,6 +40,11 @@ AptosTransaction& AptosTransaction::setSender(const String& sender) {
     return *this;
 }
 
+AptosTransaction& AptosTransaction::setSender(const AccountAddress& sender) {
+    transaction["sender"] = sender.toString();
+    return *this;
+}
+
 AptosTransaction& AptosTransaction::setSequenceNumber(uint64_t sequenceNumber) {
     transaction["sequence_number"] = String(sequenceNumber);
     return *this;
@@ -38,7 +66,8 @@ AptosTransaction& AptosTransaction::setExpirationTimestamp(uint64_t expirationTi
 }
 
 AptosTransaction& AptosTransaction::setChainId(uint8_t chainId) {
-    // Chain ID is typically included in the signing process
+    // Not part of the JSON body; only the BCS RawTransaction carries it
+    this->chainId = chainId;
     return *this;
 }
 
@@ -49,53 +78,105 @@ AptosTransaction& AptosTransaction::entryFunction(const String& moduleAddress, c
     return *this;
 }
 
+AptosTransaction& AptosTransaction::entryFunction(const AccountAddress& moduleAddress, const String& moduleName,
+                                                 const String& functionName, const JsonArray& typeArgs,
+                                                 const JsonArray& args) {
+    return entryFunction(moduleAddress.toString(), moduleName, functionName, typeArgs, args);
+}
+
 AptosTransaction& AptosTransaction::script(const String& code, const JsonArray& typeArgs, const JsonArray& args) {
     buildScriptPayload(code, typeArgs, args);
     return *this;
 }
 
-AptosTransaction& AptosTransaction::coinTransfer(const String& recipient, uint64_t amount,
-                                                const String& coinType) {
-    JsonArray typeArgs = transaction.createNestedArray();
-    typeArgs.add(coinType);
+AptosTransaction& AptosTransaction::entryFunctionBCS(const String& moduleAddress, const String& moduleName,
+                                                    const String& functionName, const JsonArray& typeArgs,
+                                                    const AptosBCSWriter& args, size_t argCount) {
+    JsonObject payload = transaction.createNestedObject("payload");
+    payload["type"] = "entry_function_payload";
+    payload["function"] = AptosUtils::padHexAddress(moduleAddress) + "::" + moduleName + "::" + functionName;
+    payload["type_arguments"] = typeArgs;
     
-    JsonArray args = transaction.createNestedArray();
-    args.add(AptosUtils::padHexAddress(recipient));
-    args.add(String(amount));
+    beginEntryFunctionBCS(moduleAddress, moduleName, functionName);
+    bool typeArgsValid = true;
+    payloadBcs.writeVectorLength(typeArgs.size());
+    for (JsonVariant typeArg : typeArgs) {
+        typeArgsValid = serializeTypeTag(payloadBcs, typeArg.as<String>()) && typeArgsValid;
+    }
+    payloadBcs.writeVectorLength(argCount);
+    payloadBcs.writeFixedBytes(args.data(), args.size());
     
-    return entryFunction("0x1", "aptos_account", "transfer_coins", typeArgs, args);
+    return finishEntryFunctionBCS(typeArgsValid && args.ok());
+}
+
+AptosTransaction& AptosTransaction::entryFunctionBCS(const AccountAddress& moduleAddress, const String& moduleName,
+                                                    const String& functionName, const JsonArray& typeArgs,
+                                                    const AptosBCSWriter& args, size_t argCount) {
+    return entryFunctionBCS(moduleAddress.toString(), moduleName, functionName, typeArgs, args, argCount);
+}
+
+AptosTransaction& AptosTransaction::coinTransfer(const String& recipient, uint64_t amount,
+                                                const String& coinType) {
+    AccountAddress address;
+    if (!address.parse(recipient)) {
+        return invalidAddress(recipient);
+    }
+    return coinTransfer(address, amount, coinType);
+}
+
+AptosTransaction& AptosTransaction::coinTransfer(const AccountAddress& recipient, uint64_t amount,
+                                                const String& coinType) {
+    // APT transfers skip parsing the type tag
+    if (coinType == APTOS_COIN_TYPE.name) {
+        return entryFunction(APTOS_TRANSFER_COINS, {APTOS_COIN_TYPE}, recipient, amount);
+    }
+    return entryFunction(APTOS_TRANSFER_COINS, {coinType}, recipient, amount);
+}
+
+AptosTransaction& AptosTransaction::coinTransfer(const AccountAddress& recipient, uint64_t amount,
+                                                const AptosTypeTag& coinType) {
+    return entryFunction(APTOS_TRANSFER_COINS, {coinType}, recipient, amount);
 }
 
 AptosTransaction& AptosTransaction::tokenTransfer(const String& recipient, const String& creator,
                                                  const String& collection, const String& tokenName,
                                                  uint64_t amount) {
-    JsonArray typeArgs = transaction.createNestedArray();
-    
-    JsonArray args = transaction.createNestedArray();
-    args.add(AptosUtils::padHexAddress(creator));
-    args.add(collection);
-    args.add(tokenName);
-    args.add(AptosUtils::padHexAddress(recipient));
-    args.add(String(amount));
-    
-    return entryFunction("0x3", "token", "direct_transfer_script", typeArgs, args);
+    AccountAddress recipientAddress;
+    AccountAddress creatorAddress;
+    if (!recipientAddress.parse(recipient)) {
+        return invalidAddress(recipient);
+    }
+    if (!creatorAddress.parse(creator)) {
+        return invalidAddress(creator);
+    }
+    return tokenTransfer(recipientAddress, creatorAddress, collection, tokenName, amount);
+}
+
+AptosTransaction& AptosTransaction::tokenTransfer(const AccountAddress& recipient, const AccountAddress& creator,
+                                                 const String& collection, const String& tokenName,
+                                                 uint64_t amount) {
+    return entryFunction(APTOS_TOKEN_DIRECT_TRANSFER, {}, creator, collection, tokenName, recipient, amount);
 }
 
 AptosTransaction& AptosTransaction::createAccount(const String& authKey) {
-    JsonArray typeArgs = transaction.createNestedArray();
-    
-    JsonArray args = transaction.createNestedArray();
-    args.add(AptosUtils::padHexAddress(authKey));
-    
-    return entryFunction("0x1", "aptos_account", "create_account", typeArgs, args);
+    AccountAddress address;
+    if (!address.parse(authKey)) {
+        return invalidAddress(authKey);
+    }
+    return createAccount(address);
+}
+
+AptosTransaction& AptosTransaction::createAccount(const AccountAddress& authKey) {
+    return entryFunction(APTOS_CREATE_ACCOUNT, {}, authKey);
 }
 
 AptosTransaction& AptosTransaction::createCollection(const String& name, const String& description,
                                                     const String& uri, uint64_t maximum,
                                                     const JsonArray& mutateSettings) {
-    JsonArray typeArgs = transaction.createNestedArray();
+    JsonDocument lists;
+    JsonArray typeArgs = lists.createNestedArray("type_arguments");
     
-    JsonArray args = transaction.createNestedArray();
+    JsonArray args = lists.createNestedArray("arguments");
     args.add(name);
     args.add(description);
     args.add(uri);
@@ -106,15 +187,26 @@ AptosTransaction& AptosTransaction::createCollection(const String& name, const S
         args.add(setting);
     }
     
-    return entryFunction("0x3", "token", "create_collection_script", typeArgs, args);
+    entryFunction("0x3", "token", "create_collection_script", typeArgs, args);
+    
+    beginEntryFunctionBCS("0x3", "token", "create_collection_script");
+    payloadBcs.writeVectorLength(0);
+    payloadBcs.writeVectorLength(5);
+    writeStringArg(payloadBcs, name);
+    writeStringArg(payloadBcs, description);
+    writeStringArg(payloadBcs, uri);
+    writeU64Arg(payloadBcs, maximum);
+    writeBoolVectorArg(payloadBcs, mutateSettings);
+    return finishEntryFunctionBCS(true);
 }
 
 AptosTransaction& AptosTransaction::createToken(const String& collection, const String& name,
                                                const String& description, uint64_t supply,
                                                const String& uri, const JsonArray& mutateSettings) {
-    JsonArray typeArgs = transaction.createNestedArray();
+    JsonDocument lists;
+    JsonArray typeArgs = lists.createNestedArray("type_arguments");
     
-    JsonArray args = transaction.createNestedArray();
+    JsonArray args = lists.createNestedArray("arguments");
     args.add(collection);
     args.add(name);
     args.add(description);
@@ -126,7 +218,18 @@ AptosTransaction& AptosTransaction::createToken(const String& collection, const
         args.add(setting);
     }
     
-    return entryFunction("0x3", "token", "create_token_script", typeArgs, args);
+    entryFunction("0x3", "token", "create_token_script", typeArgs, args);
+    
+    beginEntryFunctionBCS("0x3", "token", "create_token_script");
+    payloadBcs.writeVectorLength(0);
+    payloadBcs.writeVectorLength(6);
+    writeStringArg(payloadBcs, collection);
+    writeStringArg(payloadBcs, name);
+    writeStringArg(payloadBcs, description);
+    writeU64Arg(payloadBcs, supply);
+    writeStringArg(payloadBcs, uri);
+    writeBoolVectorArg(payloadBcs, mutateSettings);
+    return finishEntryFunctionBCS(true);
 }
 
 AptosTransaction& AptosTransaction::publishModule(const String& moduleCode) {
@@ -137,15 +240,23 @@ AptosTransaction& AptosTransaction::publishModule(const String& moduleCode) {
     JsonObject module = modules.createNestedObject();
     module["bytecode"] = moduleCode;
     
+    payloadBcs.clear();
+    hasBcsPayload = false;
     return *this;
 }
 
 AptosTransaction& AptosTransaction::callContract(const String& contractAddress, const String& moduleName,
                                                 const String& functionName, const JsonArray& args) {
-    JsonArray typeArgs = transaction.createNestedArray();
+    JsonDocument lists;
+    JsonArray typeArgs = lists.createNestedArray("type_arguments");
     return entryFunction(contractAddress, moduleName, functionName, typeArgs, args);
 }
 
+AptosTransaction& AptosTransaction::callContract(const AccountAddress& contractAddress, const String& moduleName,
+                                                const String& functionName, const JsonArray& args) {
+    return callContract(contractAddress.toString(), moduleName, functionName, args);
+}
+
 bool AptosTransaction::buildEntryFunctionPayload(const String& moduleAddress, const String& moduleName,
                                                 const String& functionName, const JsonArray& typeArgs,
                                                 const JsonArray& args) {
@@ -155,6 +266,9 @@ bool AptosTransaction::buildEntryFunctionPayload(const String& moduleAddress, co
     payload["type_arguments"] = typeArgs;
     payload["arguments"] = args;
     
+    // Untyped JSON arguments have no BCS encoding
+    payloadBcs.clear();
+    hasBcsPayload = false;
     return true;
 }
 
@@ -165,9 +279,213 @@ bool AptosTransaction::buildScriptPayload(const String& code, const JsonArray& t
     payload["type_arguments"] = typeArgs;
     payload["arguments"] = args;
     
+    payloadBcs.clear();
+    hasBcsPayload = false;
+    return true;
+}
+
+bool AptosTransaction::beginEntryFunctionBCS(const String& moduleAddress, const String& moduleName,
+                                            const String& functionName) {
+    payloadBcs.clear();
+    hasBcsPayload = false;
+    
+    // EntryFunction { module: ModuleId { address, name }, function, ty_args, args }
+    payloadBcs.writeVariantIndex(PAYLOAD_VARIANT_ENTRY_FUNCTION);
+    payloadBcs.writeAddress(moduleAddress);
+    payloadBcs.writeString(moduleName);
+    return payloadBcs.writeString(functionName);
+}
+
+bool AptosTransaction::beginEntryFunction(const AptosMoveDescriptor& function, const AptosTypeArg* typeArgs,
+                                          size_t typeArgCount, size_t argCount, JsonArray& args) {
+    // Copied as const char*: the descriptor's arrays are not string literals
+    JsonObject payload = transaction.createNestedObject("payload");
+    payload["type"] = "entry_function_payload";
+    payload["function"] = (const char*)function.name;
+    JsonArray types = payload.createNestedArray("type_arguments");
+    args = payload.createNestedArray("arguments");
+    
+    payloadBcs.clear();
+    hasBcsPayload = false;
+    payloadBcs.writeFixedBytes(function.bcs, function.bcsLength);
+    payloadBcs.writeVectorLength(typeArgCount);
+    bool valid = function.valid;
+    for (size_t i = 0; i < typeArgCount; i++) {
+        if (typeArgs[i].tag != nullptr) {
+            types.add((const char*)typeArgs[i].tag->name);
+            payloadBcs.writeFixedBytes(typeArgs[i].tag->bcs, typeArgs[i].tag->bcsLength);
+            valid = valid && typeArgs[i].tag->valid;
+        } else if (typeArgs[i].text != nullptr) {
+            types.add(*typeArgs[i].text);
+            valid = serializeTypeTag(payloadBcs, *typeArgs[i].text) && valid;
+        } else {
+            // Fewer type arguments than the function takes
+            valid = false;
+        }
+    }
+    payloadBcs.writeVectorLength(argCount);
+    return valid;
+}
+
+AptosTransaction& AptosTransaction::finishEntryFunctionBCS(bool valid) {
+    hasBcsPayload = valid && payloadBcs.ok();
+    if (!hasBcsPayload) {
+        lastError = "Failed to encode BCS payload";
+    }
+    return *this;
+}
+
+AptosTransaction& AptosTransaction::invalidAddress(const String& address) {
+    // No payload, so build() fails as well
+    transaction.remove("payload");
+    payloadBcs.clear();
+    hasBcsPayload = false;
+    lastError = "Invalid address: " + address;
+    return *this;
+}
+
+// Entry function arguments are vector<u8>, each holding the value's own BCS encoding
+
+bool AptosTransaction::writeU64Arg(AptosBCSWriter& writer, uint64_t value) {
+    writer.writeVectorLength(8);
+    return writer.writeU64(value);
+}
+
+bool AptosTransaction::writeStringArg(AptosBCSWriter& writer, const String& value) {
+    writer.writeVectorLength(AptosBCSWriter::uleb128Size(value.length()) + value.length());
+    return writer.writeString(value);
+}
+
+bool AptosTransaction::writeBoolVectorArg(AptosBCSWriter& writer, const JsonArray& values) {
+    writer.writeVectorLength(AptosBCSWriter::uleb128Size(values.size()) + values.size());
+    writer.writeVectorLength(values.size());
+    for (JsonVariant value : values) {
+        writer.writeBool(value.as<bool>());
+    }
+    return writer.ok();
+}
+
+static bool parseTypeTag(AptosBCSWriter& writer, const char*& p, const char* end);
+
+static void skipSpaces(const char*& p, const char* end) {
+    while (p < end && *p == ' ') p++;
+}
+
+static size_t tokenLength(const char* p, const char* end) {
+    const char* start = p;
+    while (p < end && (isalnum((unsigned char)*p) || *p == '_')) p++;
+    return p - start;
+}
+
+static bool tokenEquals(const char* token, size_t len, const char* word) {
+    return strlen(word) == len && strncmp(token, word, len) == 0;
+}
+
+static bool parseTypeTagList(AptosBCSWriter& writer, const char*& p, const char* end) {
+    // Counts the entries of "<A, B<C>, D>" first: the vector length precedes them
+    size_t count = 0;
+    int depth = 0;
+    for (const char* q = p; q < end; q++) {
+        if (*q == '<') {
+            if (depth++ == 0) count = 1;
+        } else if (*q == '>') {
+            if (--depth == 0) break;
+        } else if (*q == ',' && depth == 1) {
+            count++;
+        }
+    }
+    
+    if (depth != 0 || count == 0) {
+        return false;
+    }
+    
+    writer.writeVectorLength(count);
+    p++; // '<'
+    for (size_t i = 0; i < count; i++) {
+        if (!parseTypeTag(writer, p, end)) return false;
+        skipSpaces(p, end);
+        if (p >= end || *p != (i + 1 < count ? ',' : '>')) return false;
+        p++;
+    }
     return true;
 }
 
+static bool parseTypeTag(AptosBCSWriter& writer, const char*& p, const char* end) {
+    skipSpaces(p, end);
+    const char* token = p;
+    size_t len = tokenLength(p, end);
+    if (len == 0) return false;
+    p += len;
+    
+    if (p + 1 < end && p[0] == ':' && p[1] == ':') {
+        // Struct tag: address::module::name<type_params>
+        char address[BCS_ADDRESS_LENGTH * 2 + 3];
+        if (len >= sizeof(address)) return false;
+        memcpy(address, token, len);
+        address[len] = '\0';
+        
+        writer.writeVariantIndex(TYPE_TAG_STRUCT);
+        if (!writer.writeAddress(address)) return false;
+        
+        for (int part = 0; part < 2; part++) {
+            if (p + 1 >= end || p[0] != ':' || p[1] != ':') return false;
+            p += 2;
+            const char* ident = p;
+            size_t identLen = tokenLength(p, end);
+            if (identLen == 0) return false;
+            writer.writeString(ident, identLen);
+            p += identLen;
+        }
+        
+        skipSpaces(p, end);
+        if (p < end && *p == '<') {
+            return parseTypeTagList(writer, p, end);
+        }
+        return writer.writeVectorLength(0);
+    }
+    
+    if (tokenEquals(token, len, "vector")) {
+        skipSpaces(p, end);
+        if (p >= end || *p != '<') return false;
+        p++;
+        writer.writeVariantIndex(TYPE_TAG_VECTOR);
+        if (!parseTypeTag(writer, p, end)) return false;
+        skipSpaces(p, end);
+        if (p >= end || *p != '>') return false;
+        p++;
+        return writer.ok();
+    }
+    
+    static const struct {
+        const char* name;
+        uint8_t variant;
+    } primitives[] = {
+        {"bool", TYPE_TAG_BOOL}, {"u8", TYPE_TAG_U8}, {"u16", TYPE_TAG_U16},
+        {"u32", TYPE_TAG_U32}, {"u64", TYPE_TAG_U64}, {"u128", TYPE_TAG_U128},
+        {"u256", TYPE_TAG_U256}, {"address", TYPE_TAG_ADDRESS}, {"signer", TYPE_TAG_SIGNER}
+    };
+    
+    for (size_t i = 0; i < sizeof(primitives) / sizeof(primitives[0]); i++) {
+        if (tokenEquals(token, len, primitives[i].name)) {
+            return writer.writeVariantIndex(primitives[i].variant);
+        }
+    }
+    
+    return false;
+}
+
+bool AptosTransaction::serializeTypeTag(AptosBCSWriter& writer, const String& typeTag) {
+    const char* p = typeTag.c_str();
+    const char* end = p + typeTag.length();
+    
+    if (!parseTypeTag(writer, p, end)) {
+        return false;
+    }
+    
+    skipSpaces(p, end);
+    return p == end && writer.ok();
+}
+
 bool AptosTransaction::build() {
     // Set default values if not provided
     if (!transaction.containsKey("max_gas_amount")) {
@@ -213,6 +531,42 @@ String AptosTransaction::serialize() const {
     return result;
 }
 
+bool AptosTransaction::serializeBCS(AptosBCSWriter& writer) {
+    if (!isBuilt && !build()) {
+        return false;
+    }
+    
+    if (!hasBcsPayload) {
+        lastError = "Payload has no BCS encoding";
+        return false;
+    }
+    
+    if (chainId == 0) {
+        lastError = "Chain ID is required";
+        return false;
+    }
+    
+    // RawTransaction fields in declaration order
+    writer.writeAddress(getSender());
+    writer.writeU64(getSequenceNumber());
+    writer.writeFixedBytes(payloadBcs.data(), payloadBcs.size());
+    writer.writeU64(getMaxGasAmount());
+    writer.writeU64(getGasUnitPrice());
+    writer.writeU64(getExpirationTimestamp());
+    writer.writeU8(chainId);
+    
+    if (!writer.ok()) {
+        lastError = "Failed to encode BCS transaction";
+        return false;
+    }
+    
+    return true;
+}
+
+bool AptosTransaction::hasBCSPayload() const {
+    return hasBcsPayload;
+}
+
 bool AptosTransaction::isValid() const {
     return isBuilt && !lastError.length();
 }
@@ -242,11 +596,14 @@ uint64_t AptosTransaction::getExpirationTimestamp() const {
 }
 
 uint8_t AptosTransaction::getChainId() const {
-    return 1; // Default to mainnet
+    return chainId; // 0 until setChainId() is called
 }
 
 void AptosTransaction::reset() {
     transaction.clear();
+    payloadBcs.clear();
+    hasBcsPayload = false;
+    chainId = 0;
     isBuilt = false;
     lastError = "";
 }
@@ -263,11 +620,30 @@ String AptosTransaction::getHash() const {
     return AptosUtils::generateTransactionHash(transaction);
 }
 
+void AptosTransaction::hashSignedTransaction(const uint8_t* signedTxn, size_t length, uint8_t* hash) {
+    // Built once; each hash starts from a copy instead of re-absorbing the prefix
+    static const AptosSHA3 prefixed = makeUserTransactionHasher();
+    
+    AptosSHA3 hasher = prefixed;
+    hasher.update(signedTxn, length);
+    hasher.finish(hash);
+}
+
 AptosTransaction AptosTransaction::createCoinTransfer(const String& sender, const String& recipient,
                                                      uint64_t amount, uint64_t sequenceNumber,
                                                      uint64_t maxGas, uint64_t gasPrice) {
     AptosTransaction txn;
-    JsonArray args = txn.transaction.createNestedArray();
+    return txn.setSender(sender)
+              .setSequenceNumber(sequenceNumber)
+              .setMaxGasAmount(maxGas)
+              .setGasUnitPrice(gasPrice)
+              .coinTransfer(recipient, amount);
+}
+
+AptosTransaction AptosTransaction::createCoinTransfer(const AccountAddress& sender, const AccountAddress& recipient,
+                                                     uint64_t amount, uint64_t sequenceNumber,
+                                                     uint64_t maxGas, uint64_t gasPrice) {
+    AptosTransaction txn;
     return txn.setSender(sender)
               .setSequenceNumber(sequenceNumber)
               .setMaxGasAmount(maxGas)
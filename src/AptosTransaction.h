@@ -4,6 +4,9 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include "AptosUtils.h"
+#include "AptosBCS.h"
+#include "AptosSHA3.h"
+#include "AptosMoveDescriptors.h"
 
 // Transaction types
 enum TransactionType {
@@ -23,6 +26,9 @@ enum PayloadType {
 class AptosTransaction {
 private:
     JsonDocument transaction;
+    AptosBCSWriter payloadBcs;
+    bool hasBcsPayload;
+    uint8_t chainId;
     bool isBuilt;
     String lastError;
     
@@ -32,6 +38,17 @@ private:
                                   const JsonArray& args);
     bool buildScriptPayload(const String& code, const JsonArray& typeArgs, const JsonArray& args);
     
+    // BCS payload encoding (TransactionPayload::EntryFunction)
+    bool beginEntryFunctionBCS(const String& moduleAddress, const String& moduleName,
+                              const String& functionName);
+    AptosTransaction& finishEntryFunctionBCS(bool valid);
+    bool beginEntryFunction(const AptosMoveDescriptor& function, const AptosTypeArg* typeArgs,
+                            size_t typeArgCount, size_t argCount, JsonArray& args);
+    AptosTransaction& invalidAddress(const String& address);
+    static bool writeU64Arg(AptosBCSWriter& writer, uint64_t value);
+    static bool writeStringArg(AptosBCSWriter& writer, const String& value);
+    static bool writeBoolVectorArg(AptosBCSWriter& writer, const JsonArray& values);
+    
 public:
     // Constructors
     AptosTransaction();
@@ -40,6 +57,7 @@ public:
     
     // Transaction builder methods
     AptosTransaction& setSender(const String& sender);
+    AptosTransaction& setSender(const AccountAddress& sender);
     AptosTransaction& setSequenceNumber(uint64_t sequenceNumber);
     AptosTransaction& setMaxGasAmount(uint64_t maxGasAmount);
     AptosTransaction& setGasUnitPrice(uint64_t gasUnitPrice);
@@ -50,15 +68,54 @@ public:
     AptosTransaction& entryFunction(const String& moduleAddress, const String& moduleName,
                                    const String& functionName, const JsonArray& typeArgs,
                                    const JsonArray& args);
+    AptosTransaction& entryFunction(const AccountAddress& moduleAddress, const String& moduleName,
+                                   const String& functionName, const JsonArray& typeArgs,
+                                   const JsonArray& args);
     AptosTransaction& script(const String& code, const JsonArray& typeArgs, const JsonArray& args);
     
-    // Pre-built transaction types
+    // Entry function with BCS arguments: each argument is written to args with
+    // writeBytes() holding its own BCS encoding
+    AptosTransaction& entryFunctionBCS(const String& moduleAddress, const String& moduleName,
+                                      const String& functionName, const JsonArray& typeArgs,
+                                      const AptosBCSWriter& args, size_t argCount);
+    AptosTransaction& entryFunctionBCS(const AccountAddress& moduleAddress, const String& moduleName,
+                                      const String& functionName, const JsonArray& typeArgs,
+                                      const AptosBCSWriter& args, size_t argCount);
+    
+    // Entry function from a compile-time descriptor (AptosMoveDescriptors.h):
+    //   txn.entryFunction(APTOS_TRANSFER_COINS, {APTOS_COIN_TYPE}, recipient, amount);
+    // The name and BCS prefix are copied from the descriptor; only the
+    // arguments are encoded.
+    template <size_t TypeArgCount, typename... Args>
+    AptosTransaction& entryFunction(const AptosEntryFunction<TypeArgCount, Args...>& function,
+                                   const AptosTypeArgs<TypeArgCount>& typeArgs,
+                                   const typename AptosMoveArg<Args>::Value&... args) {
+        JsonArray jsonArgs;
+        bool valid = beginEntryFunction(function, typeArgs.args, TypeArgCount, sizeof...(Args), jsonArgs);
+        // Braced initializers run in order, so the arguments are written first to last
+        bool written[] = {valid, AptosMoveArg<Args>::write(payloadBcs, jsonArgs, args)...};
+        for (bool ok : written) {
+            valid = valid && ok;
+        }
+        return finishEntryFunctionBCS(valid);
+    }
+    
+    // Pre-built transaction types. The String forms fail (see getError())
+    // on an address that does not parse.
     AptosTransaction& coinTransfer(const String& recipient, uint64_t amount,
                                   const String& coinType = "0x1::aptos_coin::AptosCoin");
+    AptosTransaction& coinTransfer(const AccountAddress& recipient, uint64_t amount,
+                                  const String& coinType = "0x1::aptos_coin::AptosCoin");
+    AptosTransaction& coinTransfer(const AccountAddress& recipient, uint64_t amount,
+                                  const AptosTypeTag& coinType);
     AptosTransaction& tokenTransfer(const String& recipient, const String& creator,
                                    const String& collection, const String& tokenName,
                                    uint64_t amount);
+    AptosTransaction& tokenTransfer(const AccountAddress& recipient, const AccountAddress& creator,
+                                   const String& collection, const String& tokenName,
+                                   uint64_t amount);
     AptosTransaction& createAccount(const String& authKey);
+    AptosTransaction& createAccount(const AccountAddress& authKey);
     AptosTransaction& createCollection(const String& name, const String& description,
                                       const String& uri, uint64_t maximum,
                                       const JsonArray& mutateSettings);
@@ -70,11 +127,21 @@ public:
     AptosTransaction& publishModule(const String& moduleCode);
     AptosTransaction& callContract(const String& contractAddress, const String& moduleName,
                                   const String& functionName, const JsonArray& args);
+    AptosTransaction& callContract(const AccountAddress& contractAddress, const String& moduleName,
+                                  const String& functionName, const JsonArray& args);
+    template <size_t TypeArgCount, typename... Args>
+    AptosTransaction& callContract(const AptosEntryFunction<TypeArgCount, Args...>& function,
+                                  const AptosTypeArgs<TypeArgCount>& typeArgs,
+                                  const typename AptosMoveArg<Args>::Value&... args) {
+        return entryFunction(function, typeArgs, args...);
+    }
     
     // Transaction finalization
     bool build();
     JsonDocument& getTransaction();
     String serialize() const;
+    bool serializeBCS(AptosBCSWriter& writer);
+    bool hasBCSPayload() const;
     bool isValid() const;
     String getError() const;
     
@@ -95,10 +162,25 @@ public:
     static AptosTransaction createCoinTransfer(const String& sender, const String& recipient,
                                               uint64_t amount, uint64_t sequenceNumber,
                                               uint64_t maxGas = 2000, uint64_t gasPrice = 100);
+    static AptosTransaction createCoinTransfer(const AccountAddress& sender, const AccountAddress& recipient,
+                                              uint64_t amount, uint64_t sequenceNumber,
+                                              uint64_t maxGas = 2000, uint64_t gasPrice = 100);
     static AptosTransaction createAccountTransaction(const String& sender, const String& authKey,
                                                     uint64_t sequenceNumber,
                                                     uint64_t maxGas = 2000, uint64_t gasPrice = 100);
     
+    // Move type tags ("u64", "vector<u8>", "0x1::aptos_coin::AptosCoin")
+    static bool serializeTypeTag(AptosBCSWriter& writer, const String& typeTag);
+    
+    // On-chain hash of a BCS SignedTransaction:
+    // SHA3-256(TRANSACTION_PREFIX || 0x00 (UserTransaction) || signedTxn)
+    static void hashSignedTransaction(const uint8_t* signedTxn, size_t length, uint8_t* hash);
+    
+    // SHA3-256("APTOS::RawTransaction"), prepended to the BCS RawTransaction when signing
+    static const uint8_t RAW_TRANSACTION_PREFIX[32];
+    // SHA3-256("APTOS::Transaction"), prepended to a Transaction when hashing
+    static const uint8_t TRANSACTION_PREFIX[32];
+    
     // Default values
     static const uint64_t DEFAULT_MAX_GAS = 2000;
     static const uint64_t DEFAULT_GAS_PRICE = 100;
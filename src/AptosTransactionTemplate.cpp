@@ -0,0 +1,158 @@
+#include "AptosTransactionTemplate.h"
+
+// RawTransaction.sequence_number follows the 32-byte sender
+#define TEMPLATE_SEQUENCE_OFFSET ACCOUNT_ADDRESS_LENGTH
+
+AptosTransactionTemplate::AptosTransactionTemplate()
+    : length(0), recipientOffset(0), amountOffset(0), expirationOffset(0), valid(false) {
+}
+
+bool AptosTransactionTemplate::coinTransfer(const AccountAddress& sender, uint8_t chainId,
+                                            const AptosTypeTag& coinType, uint64_t maxGas, uint64_t gasPrice) {
+    AptosBCSWriter writer(raw, sizeof(raw));
+    if (!beginCoinTransfer(writer, sender) || !coinType.valid) {
+        valid = false;
+        length = 0;
+        return false;
+    }
+    writer.writeFixedBytes(coinType.bcs, coinType.bcsLength);
+    return finishCoinTransfer(writer, chainId, maxGas, gasPrice);
+}
+
+bool AptosTransactionTemplate::coinTransfer(const AccountAddress& sender, uint8_t chainId,
+                                            const String& coinType, uint64_t maxGas, uint64_t gasPrice) {
+    AptosBCSWriter writer(raw, sizeof(raw));
+    if (!beginCoinTransfer(writer, sender) || !AptosTransaction::serializeTypeTag(writer, coinType)) {
+        valid = false;
+        length = 0;
+        return false;
+    }
+    return finishCoinTransfer(writer, chainId, maxGas, gasPrice);
+}
+
+bool AptosTransactionTemplate::beginCoinTransfer(AptosBCSWriter& writer, const AccountAddress& sender) {
+    // Everything up to the coin type
+    writer.writeAddress(sender);
+    writer.writeU64(0);
+    writer.writeFixedBytes(APTOS_TRANSFER_COINS.bcs, APTOS_TRANSFER_COINS.bcsLength);
+    writer.writeVectorLength(1);
+    return writer.ok();
+}
+
+bool AptosTransactionTemplate::finishCoinTransfer(AptosBCSWriter& writer, uint8_t chainId,
+                                                  uint64_t maxGas, uint64_t gasPrice) {
+    // Arguments are vector<u8> holding each value's BCS encoding
+    writer.writeVectorLength(2);
+    writer.writeVectorLength(ACCOUNT_ADDRESS_LENGTH);
+    recipientOffset = writer.size();
+    writer.writeAddress(AccountAddress::ZERO);
+    writer.writeVectorLength(8);
+    amountOffset = writer.size();
+    writer.writeU64(0);
+
+    writer.writeU64(maxGas);
+    writer.writeU64(gasPrice);
+    expirationOffset = writer.size();
+    writer.writeU64(0);
+    writer.writeU8(chainId);
+
+    valid = writer.ok() && chainId != 0;
+    length = valid ? writer.size() : 0;
+    return valid;
+}
+
+uint64_t AptosTransactionTemplate::readU64(size_t offset) const {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | raw[offset + i];
+    }
+    return value;
+}
+
+void AptosTransactionTemplate::writeU64(size_t offset, uint64_t value) {
+    // Little-endian, as AptosBCSWriter::writeU64
+    for (int i = 0; i < 8; i++) {
+        raw[offset + i] = (value >> (i * 8)) & 0xFF;
+    }
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setRecipient(const AccountAddress& recipient) {
+    if (valid) {
+        memcpy(raw + recipientOffset, recipient.data(), ACCOUNT_ADDRESS_LENGTH);
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setAmount(uint64_t amount) {
+    if (valid) {
+        writeU64(amountOffset, amount);
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setSequenceNumber(uint64_t sequenceNumber) {
+    if (valid) {
+        writeU64(TEMPLATE_SEQUENCE_OFFSET, sequenceNumber);
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setExpirationTimestamp(uint64_t expirationTimestamp) {
+    if (valid) {
+        writeU64(expirationOffset, expirationTimestamp);
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setMaxGasAmount(uint64_t maxGasAmount) {
+    if (valid) {
+        writeU64(expirationOffset - 16, maxGasAmount);
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setGasUnitPrice(uint64_t gasUnitPrice) {
+    if (valid) {
+        writeU64(expirationOffset - 8, gasUnitPrice);
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::setChainId(uint8_t chainId) {
+    if (valid && chainId != 0) {
+        raw[expirationOffset + 8] = chainId;
+    }
+    return *this;
+}
+
+AptosTransactionTemplate& AptosTransactionTemplate::patch(const AccountAddress& recipient, uint64_t amount,
+                                                          uint64_t sequenceNumber, uint64_t expirationTimestamp) {
+    return setRecipient(recipient)
+          .setAmount(amount)
+          .setSequenceNumber(sequenceNumber)
+          .setExpirationTimestamp(expirationTimestamp);
+}
+
+const uint8_t* AptosTransactionTemplate::data() const {
+    return raw;
+}
+
+size_t AptosTransactionTemplate::size() const {
+    return length;
+}
+
+bool AptosTransactionTemplate::isValid() const {
+    return valid;
+}
+
+uint64_t AptosTransactionTemplate::getAmount() const {
+    return valid ? readU64(amountOffset) : 0;
+}
+
+uint64_t AptosTransactionTemplate::getSequenceNumber() const {
+    return valid ? readU64(TEMPLATE_SEQUENCE_OFFSET) : 0;
+}
+
+uint64_t AptosTransactionTemplate::getExpirationTimestamp() const {
+    return valid ? readU64(expirationOffset) : 0;
+}
@@ -0,0 +1,80 @@
+#ifndef APTOS_TRANSACTION_TEMPLATE_H
+#define APTOS_TRANSACTION_TEMPLATE_H
+
+#include <Arduino.h>
+#include "AptosTransaction.h"
+
+// Room for a RawTransaction: sender, sequence number, payload (function,
+// coin type, two arguments), gas, expiration and chain id. The APT transfer
+// takes 226 bytes; the rest is for longer coin types.
+#ifndef APTOS_TRANSACTION_TEMPLATE_SIZE
+#define APTOS_TRANSACTION_TEMPLATE_SIZE 384
+#endif
+
+// A BCS RawTransaction for 0x1::aptos_account::transfer_coins, encoded once
+// and reused for every transfer from the same sender.
+//
+// coinTransfer() writes the parts that do not change (sender, function,
+// coin type, gas settings, chain id); the setters then overwrite the
+// recipient, amount, sequence number and expiration in place, at offsets
+// recorded when the template was built. Nothing is allocated after that:
+//
+//   AptosTransactionTemplate transfer;
+//   transfer.coinTransfer(account.getAccountAddress(), chainId);
+//   ...
+//   transfer.patch(recipient, amount, sequenceNumber, expiration);
+//   account.signTransaction(transfer, signedTxn);
+//   sdk.submitTransactionBCS(signedTxn.data(), signedTxn.size(), response);
+//
+// The bytes are exactly what AptosTransaction::serializeBCS() gives for the
+// same coinTransfer(). Sequence numbers are the caller's to track.
+class AptosTransactionTemplate {
+private:
+    uint8_t raw[APTOS_TRANSACTION_TEMPLATE_SIZE];
+    size_t length;
+    size_t recipientOffset;
+    size_t amountOffset;
+    size_t expirationOffset;   // Max gas and gas price precede it, the chain id follows
+    bool valid;
+
+    bool beginCoinTransfer(AptosBCSWriter& writer, const AccountAddress& sender);
+    bool finishCoinTransfer(AptosBCSWriter& writer, uint8_t chainId, uint64_t maxGas, uint64_t gasPrice);
+    uint64_t readU64(size_t offset) const;
+    void writeU64(size_t offset, uint64_t value);
+
+public:
+    AptosTransactionTemplate();
+
+    // Encodes a transfer_coins call; recipient, amount, sequence number and
+    // expiration start at zero. False if the coin type does not parse or
+    // chainId is 0.
+    bool coinTransfer(const AccountAddress& sender, uint8_t chainId,
+                      const AptosTypeTag& coinType = APTOS_COIN_TYPE,
+                      uint64_t maxGas = AptosTransaction::DEFAULT_MAX_GAS,
+                      uint64_t gasPrice = AptosTransaction::DEFAULT_GAS_PRICE);
+    bool coinTransfer(const AccountAddress& sender, uint8_t chainId, const String& coinType,
+                      uint64_t maxGas = AptosTransaction::DEFAULT_MAX_GAS,
+                      uint64_t gasPrice = AptosTransaction::DEFAULT_GAS_PRICE);
+
+    // In-place patching; ignored until coinTransfer() succeeded
+    AptosTransactionTemplate& setRecipient(const AccountAddress& recipient);
+    AptosTransactionTemplate& setAmount(uint64_t amount);
+    AptosTransactionTemplate& setSequenceNumber(uint64_t sequenceNumber);
+    AptosTransactionTemplate& setExpirationTimestamp(uint64_t expirationTimestamp);
+    AptosTransactionTemplate& setMaxGasAmount(uint64_t maxGasAmount);
+    AptosTransactionTemplate& setGasUnitPrice(uint64_t gasUnitPrice);
+    AptosTransactionTemplate& setChainId(uint8_t chainId);
+    AptosTransactionTemplate& patch(const AccountAddress& recipient, uint64_t amount,
+                                    uint64_t sequenceNumber, uint64_t expirationTimestamp);
+
+    // The RawTransaction, ready to be signed
+    const uint8_t* data() const;
+    size_t size() const;
+    bool isValid() const;
+
+    uint64_t getAmount() const;
+    uint64_t getSequenceNumber() const;
+    uint64_t getExpirationTimestamp() const;
+};
+
+#endif
@@ -0,0 +1,239 @@
+#include "AptosTransactionTracker.h"
+
+// Committed transactions read per sender and poll; the node caps pages at 100
+#define APTOS_TRACKER_PAGE_LIMIT 100
+
+static String jsonString(JsonVariantConst value) {
+    const char* text = value.as<const char*>();
+    return text != nullptr ? String(text) : String();
+}
+
+AptosTransactionTracker::AptosTransactionTracker(AptosSDK& sdk)
+    : sdk(sdk), nextId(1), nextOrder(0), pollIntervalMs(APTOS_TRACKER_DEFAULT_POLL_MS),
+      timeoutMs(APTOS_TRACKER_DEFAULT_TIMEOUT_MS), lastPollMs(0), callback(nullptr),
+      callbackContext(nullptr) {
+    clear();
+}
+
+void AptosTransactionTracker::setCallback(AptosTrackerCallback callback, void* context) {
+    this->callback = callback;
+    callbackContext = context;
+}
+
+void AptosTransactionTracker::setPollInterval(uint32_t ms) {
+    pollIntervalMs = ms;
+}
+
+void AptosTransactionTracker::setTimeout(uint32_t ms) {
+    timeoutMs = ms;
+}
+
+AptosTransactionTracker::Entry* AptosTransactionTracker::add(const String& txnHash, const String& sender,
+                                                             uint64_t sequenceNumber, bool located) {
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        Entry& entry = entries[i];
+        if (entry.state != ENTRY_FREE) {
+            continue;
+        }
+        entry.state = ENTRY_PENDING;
+        entry.located = located;
+        entry.trackedAt = millis();
+        entry.result.id = nextId++;
+        entry.result.hash = txnHash;
+        entry.result.sender = sender;
+        entry.result.sequenceNumber = sequenceNumber;
+        entry.result.status = APTOS_TXN_PENDING;
+        entry.result.version = 0;
+        entry.result.vmStatus = "";
+        return &entry;
+    }
+    return nullptr;
+}
+
+bool AptosTransactionTracker::trackHash(const String& txnHash, uint32_t* id) {
+    Entry* entry = add(txnHash, "", 0, false);
+    if (entry != nullptr && id != nullptr) {
+        *id = entry->result.id;
+    }
+    return entry != nullptr;
+}
+
+bool AptosTransactionTracker::trackSequence(const String& sender, uint64_t sequenceNumber,
+                                            const String& txnHash, uint32_t* id) {
+    Entry* entry = add(txnHash, sdk.normalizeAddress(sender), sequenceNumber, true);
+    if (entry != nullptr && id != nullptr) {
+        *id = entry->result.id;
+    }
+    return entry != nullptr;
+}
+
+void AptosTransactionTracker::finish(Entry& entry, AptosTransactionStatus status, uint64_t version,
+                                     const String& vmStatus) {
+    entry.result.status = status;
+    entry.result.version = version;
+    entry.result.vmStatus = vmStatus;
+
+    if (callback == nullptr) {
+        entry.state = ENTRY_DONE;
+        entry.order = nextOrder++;
+        return;
+    }
+
+    // Freed first, so the callback may track the next transaction
+    AptosTrackedTransaction result = entry.result;
+    entry.state = ENTRY_FREE;
+    callback(result, callbackContext);
+}
+
+void AptosTransactionTracker::locate(Entry& entry, int& completed) {
+    JsonDocument transaction;
+    if (!sdk.getTransactionByHash(entry.result.hash, transaction,
+                                  AptosSDK::responseFilter(APTOS_FILTER_TRANSACTION_STATUS))) {
+        return;
+    }
+
+    AptosTransactionStatus status = AptosSDK::transactionStatus(transaction);
+    if (status == APTOS_TXN_SUCCESS || status == APTOS_TXN_FAILED) {
+        entry.result.sender = sdk.normalizeAddress(jsonString(transaction["sender"]));
+        entry.result.sequenceNumber = AptosUtils::jsonUint64(transaction["sequence_number"]);
+        finish(entry, status, AptosUtils::jsonUint64(transaction["version"]), jsonString(transaction["vm_status"]));
+        completed++;
+    } else if (status == APTOS_TXN_PENDING) {
+        // From now on it is resolved together with its sender's other transactions
+        entry.result.sender = sdk.normalizeAddress(jsonString(transaction["sender"]));
+        entry.result.sequenceNumber = AptosUtils::jsonUint64(transaction["sequence_number"]);
+        entry.located = true;
+    }
+}
+
+void AptosTransactionTracker::checkSender(const String& sender, int& completed) {
+    uint64_t lowest = UINT64_MAX;
+    uint64_t highest = 0;
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        Entry& entry = entries[i];
+        if (entry.state == ENTRY_PENDING && entry.located && entry.result.sender == sender) {
+            lowest = entry.result.sequenceNumber < lowest ? entry.result.sequenceNumber : lowest;
+            highest = entry.result.sequenceNumber > highest ? entry.result.sequenceNumber : highest;
+        }
+    }
+    if (lowest == UINT64_MAX) {
+        return;
+    }
+    uint64_t span = highest - lowest + 1;
+    int limit = span > APTOS_TRACKER_PAGE_LIMIT ? APTOS_TRACKER_PAGE_LIMIT : (int)span;
+
+    JsonDocument response;
+    if (!sdk.getAccountTransactions(sender, response, limit, (int)lowest,
+                                    AptosSDK::responseFilter(APTOS_FILTER_TRANSACTION_LIST)) ||
+        !response.is<JsonArray>()) {
+        return;
+    }
+
+    for (JsonVariantConst item : response.as<JsonArrayConst>()) {
+        uint64_t sequenceNumber = AptosUtils::jsonUint64(item["sequence_number"]);
+        String hash = jsonString(item["hash"]);
+        for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+            Entry& entry = entries[i];
+            if (entry.state != ENTRY_PENDING || !entry.located || entry.result.sender != sender ||
+                entry.result.sequenceNumber != sequenceNumber) {
+                continue;
+            }
+            if (entry.result.hash.isEmpty()) {
+                entry.result.hash = hash;
+            }
+            if (!entry.result.hash.equalsIgnoreCase(hash)) {
+                // Another transaction took the number; this one can never commit
+                finish(entry, APTOS_TXN_NOT_FOUND, 0, "Sequence number used by " + hash);
+            } else {
+                finish(entry, item["success"].as<bool>() ? APTOS_TXN_SUCCESS : APTOS_TXN_FAILED,
+                       AptosUtils::jsonUint64(item["version"]), jsonString(item["vm_status"]));
+            }
+            completed++;
+        }
+    }
+}
+
+void AptosTransactionTracker::checkTimeouts(int& completed) {
+    unsigned long now = millis();
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        Entry& entry = entries[i];
+        if (entry.state != ENTRY_PENDING || now - entry.trackedAt < timeoutMs) {
+            continue;
+        }
+        // Located entries were seen in mempool or tracked by sequence number
+        finish(entry, entry.located ? APTOS_TXN_PENDING : APTOS_TXN_NOT_FOUND, 0, "Timed out");
+        completed++;
+    }
+}
+
+int AptosTransactionTracker::poll() {
+    if (pending() == 0) {
+        return 0;
+    }
+    if (lastPollMs != 0 && millis() - lastPollMs < pollIntervalMs) {
+        return 0;
+    }
+    lastPollMs = millis();
+
+    int completed = 0;
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        if (entries[i].state == ENTRY_PENDING && !entries[i].located) {
+            locate(entries[i], completed);
+        }
+    }
+
+    // One request per sender; checkSender() settles all of its entries
+    bool checked[APTOS_TRACKER_MAX_ENTRIES] = {false};
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        if (checked[i] || entries[i].state != ENTRY_PENDING || !entries[i].located) {
+            continue;
+        }
+        String sender = entries[i].result.sender;
+        for (size_t j = i; j < APTOS_TRACKER_MAX_ENTRIES; j++) {
+            if (entries[j].state == ENTRY_PENDING && entries[j].result.sender == sender) {
+                checked[j] = true;
+            }
+        }
+        checkSender(sender, completed);
+    }
+
+    checkTimeouts(completed);
+    return completed;
+}
+
+bool AptosTransactionTracker::nextCompleted(AptosTrackedTransaction& result) {
+    Entry* oldest = nullptr;
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        if (entries[i].state == ENTRY_DONE && (oldest == nullptr || entries[i].order < oldest->order)) {
+            oldest = &entries[i];
+        }
+    }
+    if (oldest == nullptr) {
+        return false;
+    }
+    result = oldest->result;
+    oldest->state = ENTRY_FREE;
+    return true;
+}
+
+size_t AptosTransactionTracker::pending() const {
+    size_t count = 0;
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        count += entries[i].state == ENTRY_PENDING ? 1 : 0;
+    }
+    return count;
+}
+
+size_t AptosTransactionTracker::completed() const {
+    size_t count = 0;
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        count += entries[i].state == ENTRY_DONE ? 1 : 0;
+    }
+    return count;
+}
+
+void AptosTransactionTracker::clear() {
+    for (size_t i = 0; i < APTOS_TRACKER_MAX_ENTRIES; i++) {
+        entries[i].state = ENTRY_FREE;
+    }
+}
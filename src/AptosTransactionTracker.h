@@ -0,0 +1,99 @@
+#ifndef APTOS_TRANSACTION_TRACKER_H
+#define APTOS_TRANSACTION_TRACKER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "AptosSDK.h"
+
+// Transactions tracked at the same time (pending plus completed but not
+// yet taken with nextCompleted())
+#ifndef APTOS_TRACKER_MAX_ENTRIES
+#define APTOS_TRACKER_MAX_ENTRIES 32
+#endif
+
+#define APTOS_TRACKER_DEFAULT_POLL_MS 250
+#define APTOS_TRACKER_DEFAULT_TIMEOUT_MS 60000
+
+struct AptosTrackedTransaction {
+    uint32_t id;                    // As returned by trackHash() / trackSequence()
+    String hash;                    // Empty if tracked by sequence number alone
+    String sender;
+    uint64_t sequenceNumber;
+    AptosTransactionStatus status;  // SUCCESS or FAILED once committed, else why not
+    uint64_t version;               // Ledger version, 0 unless committed
+    String vmStatus;
+};
+
+typedef void (*AptosTrackerCallback)(const AptosTrackedTransaction& result, void* context);
+
+// Waits for many transactions at once without blocking.
+//
+// Each poll() (rate limited to the poll interval) costs one request per
+// sender rather than one per transaction: the sender's committed
+// transactions are read from the lowest tracked sequence number on and
+// matched by number and hash. A transaction tracked by hash alone is looked
+// up once to learn its sender and number, then joins its sender's group.
+//
+// Outcomes go to the callback when one is set, otherwise into a completion
+// queue read with nextCompleted(). A transaction whose number was taken by
+// another one finishes as APTOS_TXN_NOT_FOUND; one still unresolved after
+// the timeout finishes as APTOS_TXN_PENDING (seen in mempool) or
+// APTOS_TXN_NOT_FOUND.
+class AptosTransactionTracker {
+private:
+    enum EntryState {
+        ENTRY_FREE,
+        ENTRY_PENDING,
+        ENTRY_DONE
+    };
+
+    struct Entry {
+        EntryState state;
+        bool located;               // sender and sequenceNumber are known
+        uint32_t order;             // Completion order, for the queue
+        unsigned long trackedAt;
+        AptosTrackedTransaction result;
+    };
+
+    AptosSDK& sdk;
+    Entry entries[APTOS_TRACKER_MAX_ENTRIES];
+    uint32_t nextId;
+    uint32_t nextOrder;
+    uint32_t pollIntervalMs;
+    uint32_t timeoutMs;
+    unsigned long lastPollMs;
+    AptosTrackerCallback callback;
+    void* callbackContext;
+
+    Entry* add(const String& txnHash, const String& sender, uint64_t sequenceNumber, bool located);
+    void finish(Entry& entry, AptosTransactionStatus status, uint64_t version, const String& vmStatus);
+    void locate(Entry& entry, int& completed);
+    void checkSender(const String& sender, int& completed);
+    void checkTimeouts(int& completed);
+
+public:
+    AptosTransactionTracker(AptosSDK& sdk);
+
+    // Configuration
+    void setCallback(AptosTrackerCallback callback, void* context = nullptr);
+    void setPollInterval(uint32_t ms);
+    void setTimeout(uint32_t ms);
+
+    // Starts tracking; false when all entries are in use
+    bool trackHash(const String& txnHash, uint32_t* id = nullptr);
+    bool trackSequence(const String& sender, uint64_t sequenceNumber, const String& txnHash = "",
+                       uint32_t* id = nullptr);
+
+    // Checks pending transactions, at most once per poll interval; call it
+    // from loop(). Returns the number of transactions that finished.
+    int poll();
+
+    // Takes the oldest finished transaction from the queue (without a callback)
+    bool nextCompleted(AptosTrackedTransaction& result);
+
+    size_t pending() const;
+    size_t completed() const;
+    void clear();
+};
+
+#endif
@@ -1,45 +1,194 @@
 #include "AptosUtils.h"
+#include "AptosTransaction.h"
+#include "AptosSHA3.h"
+#include <time.h>
+
+// SSE2 path for host builds on x86; the lookup tables serve everywhere else
+#if defined(__SSE2__) && !defined(APTOS_HEX_NO_SIMD)
+#define APTOS_HEX_SSE2
+#include <emmintrin.h>
+#endif
+
+// Print sink that feeds serialized output straight into a hasher
+class SHA3Print : public Print {
+private:
+    AptosSHA3& hasher;
+
+public:
+    explicit SHA3Print(AptosSHA3& target) : hasher(target) {}
+
+    size_t write(uint8_t c) override {
+        hasher.update(c);
+        return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        hasher.update(buffer, size);
+        return size;
+    }
+};
 
 const char* AptosUtils::hexChars = "0123456789abcdef";
 
-String AptosUtils::bytesToHex(const uint8_t* bytes, size_t length) {
-    String result;
-    result.reserve(length * 2);
-    
-    for (size_t i = 0; i < length; i++) {
-        result += nibbleToHex(bytes[i] >> 4);
-        result += nibbleToHex(bytes[i] & 0x0F);
+// Both characters of every byte value, so encoding is one load per byte
+static const char hexPairs[513] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Value of every hex digit, 0xFF for anything else
+#define X 0xFF
+static const uint8_t hexValues[256] = {
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, X, X, X, X, X, X,
+    X, 10, 11, 12, 13, 14, 15, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, 10, 11, 12, 13, 14, 15, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X
+};
+#undef X
+
+#ifdef APTOS_HEX_SSE2
+// 16 bytes to 32 lowercase digits
+static inline void encodeHex16(const uint8_t* bytes, char* out) {
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i letters = _mm_set1_epi8('a' - '0' - 10);
+
+    __m128i input = _mm_loadu_si128((const __m128i*)bytes);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), mask);
+    __m128i low = _mm_and_si128(input, mask);
+    __m128i first = _mm_unpacklo_epi8(high, low);
+    __m128i second = _mm_unpackhi_epi8(high, low);
+    first = _mm_add_epi8(_mm_add_epi8(first, zero), _mm_and_si128(_mm_cmpgt_epi8(first, nine), letters));
+    second = _mm_add_epi8(_mm_add_epi8(second, zero), _mm_and_si128(_mm_cmpgt_epi8(second, nine), letters));
+    _mm_storeu_si128((__m128i*)out, first);
+    _mm_storeu_si128((__m128i*)(out + 16), second);
+}
+
+// 16 digits to their values; false if any is not a hex digit
+static inline bool hexDigits16(__m128i chars, __m128i& values) {
+    // Unsigned range checks as signed compares on values offset by 0x80
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+    __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_cmplt_epi8(_mm_xor_si128(digits, bias), _mm_set1_epi8((char)(0x80 + 10)));
+    __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isLetter = _mm_cmplt_epi8(_mm_xor_si128(letters, bias), _mm_set1_epi8((char)(0x80 + 6)));
+    letters = _mm_add_epi8(letters, _mm_set1_epi8(10));
+    values = _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, letters));
+    return _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) == 0xFFFF;
+}
+
+// 32 digits to 16 bytes
+static inline bool decodeHex32(const char* hex, uint8_t* out) {
+    __m128i first;
+    __m128i second;
+    if (!hexDigits16(_mm_loadu_si128((const __m128i*)hex), first) ||
+        !hexDigits16(_mm_loadu_si128((const __m128i*)(hex + 16)), second)) {
+        return false;
     }
-    
-    return result;
+    // Each 16-bit lane holds (high, low): combine into high << 4 | low
+    const __m128i lowByte = _mm_set1_epi16(0x00FF);
+    first = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(first, lowByte), 4), _mm_srli_epi16(first, 8));
+    second = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(second, lowByte), 4), _mm_srli_epi16(second, 8));
+    _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(first, second));
+    return true;
 }
+#endif
 
-bool AptosUtils::hexToBytes(const String& hex, uint8_t* bytes, size_t maxLength) {
-    String cleanHex = removeHexPrefix(hex);
-    
-    if (cleanHex.length() % 2 != 0) {
+size_t AptosUtils::encodeHex(const uint8_t* bytes, size_t length, char* out) {
+    size_t i = 0;
+#ifdef APTOS_HEX_SSE2
+    for (; i + 16 <= length; i += 16) {
+        encodeHex16(bytes + i, out + i * 2);
+    }
+#endif
+    for (; i < length; i++) {
+        const char* pair = &hexPairs[bytes[i] * 2];
+        out[i * 2] = pair[0];
+        out[i * 2 + 1] = pair[1];
+    }
+    out[length * 2] = '\0';
+    return length * 2;
+}
+
+bool AptosUtils::decodeHex(const char* hex, size_t hexLength, uint8_t* out, size_t maxLength,
+                           size_t* written) {
+    if (hexLength >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        hex += 2;
+        hexLength -= 2;
+    }
+    if (hexLength % 2 != 0) {
         return false; // Invalid hex length
     }
-    
-    size_t byteLength = cleanHex.length() / 2;
+    size_t byteLength = hexLength / 2;
     if (byteLength > maxLength) {
         return false; // Buffer too small
     }
-    
-    for (size_t i = 0; i < byteLength; i++) {
-        uint8_t high = hexToNibble(cleanHex.charAt(i * 2));
-        uint8_t low = hexToNibble(cleanHex.charAt(i * 2 + 1));
-        
-        if (high == 0xFF || low == 0xFF) {
+
+    size_t i = 0;
+#ifdef APTOS_HEX_SSE2
+    for (; i + 16 <= byteLength; i += 16) {
+        if (!decodeHex32(hex + i * 2, out + i)) {
             return false; // Invalid hex character
         }
-        
-        bytes[i] = (high << 4) | low;
     }
-    
+#endif
+    for (; i < byteLength; i++) {
+        uint8_t high = hexValues[(uint8_t)hex[i * 2]];
+        uint8_t low = hexValues[(uint8_t)hex[i * 2 + 1]];
+        if ((high | low) == 0xFF) {
+            return false; // Invalid hex character
+        }
+        out[i] = (high << 4) | low;
+    }
+    if (written != nullptr) {
+        *written = byteLength;
+    }
     return true;
 }
 
+uint8_t AptosUtils::hexValue(char c) {
+    return hexValues[(uint8_t)c];
+}
+
+String AptosUtils::bytesToHex(const uint8_t* bytes, size_t length) {
+    String result;
+    result.reserve(length * 2);
+    
+    // Through a stack buffer, a block at a time: no per-character appends
+    char block[129];
+    while (length > 0) {
+        size_t chunk = length > 64 ? 64 : length;
+        size_t digits = encodeHex(bytes, chunk, block);
+        result.concat(block, digits);
+        bytes += chunk;
+        length -= chunk;
+    }
+    
+    return result;
+}
+
+bool AptosUtils::hexToBytes(const String& hex, uint8_t* bytes, size_t maxLength) {
+    return decodeHex(hex.c_str(), hex.length(), bytes, maxLength);
+}
+
 String AptosUtils::toHexString(uint64_t value) {
     String result = "0x";
     
@@ -50,12 +199,25 @@ String AptosUtils::toHexString(uint64_t value) {
     
     // Convert to hex without leading zeros
     char buffer[17];
-    sprintf(buffer, "%llx", value);
+    sprintf(buffer, "%llx", (unsigned long long)value);
     result += buffer;
     
     return result;
 }
 
+String AptosUtils::toDecimalString(uint64_t value) {
+    char buffer[21];
+    snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)value);
+    return String(buffer);
+}
+
+uint64_t AptosUtils::jsonUint64(JsonVariantConst value) {
+    if (value.is<const char*>()) {
+        return strtoull(value.as<const char*>(), nullptr, 10);
+    }
+    return value.as<uint64_t>();
+}
+
 String AptosUtils::bytesToBase64(const uint8_t* bytes, size_t length) {
     size_t outputLen = 0;
     
@@ -90,23 +252,46 @@ bool AptosUtils::base64ToBytes(const String& base64, uint8_t* bytes, size_t& len
 }
 
 String AptosUtils::padHexAddress(const String& address) {
-    String addr = removeHexPrefix(address);
-    addr.toLowerCase();
+    const char* digits = address.c_str();
+    size_t length = address.length();
+    if (length >= 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+        digits += 2;
+        length -= 2;
+    }
     
-    // Pad to 64 characters
-    while (addr.length() < 64) {
-        addr = "0" + addr;
+    // Pad to 64 characters, lowercased, in one buffer
+    size_t padding = length < 64 ? 64 - length : 0;
+    char stackBuffer[67];
+    char* out = length <= 64 ? stackBuffer : (char*)malloc(length + 3);
+    if (out == nullptr) {
+        return "";
+    }
+    out[0] = '0';
+    out[1] = 'x';
+    memset(out + 2, '0', padding);
+    for (size_t i = 0; i < length; i++) {
+        char c = digits[i];
+        out[2 + padding + i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
     }
+    out[2 + padding + length] = '\0';
     
-    return "0x" + addr;
+    String result(out);
+    if (out != stackBuffer) {
+        free(out);
+    }
+    return result;
 }
 
 bool AptosUtils::isValidHexString(const String& hex) {
-    String cleanHex = removeHexPrefix(hex);
+    const char* digits = hex.c_str();
+    size_t length = hex.length();
+    if (length >= 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+        digits += 2;
+        length -= 2;
+    }
     
-    for (int i = 0; i < cleanHex.length(); i++) {
-        char c = cleanHex.charAt(i);
-        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
+    for (size_t i = 0; i < length; i++) {
+        if (hexValues[(uint8_t)digits[i]] == 0xFF) {
             return false;
         }
     }
@@ -138,68 +323,86 @@ String AptosUtils::sha256Hash(const uint8_t* data, size_t length) {
     return bytesToHex(hash, 32);
 }
 
+String AptosUtils::sha3_256Hash(const uint8_t* data, size_t length) {
+    uint8_t hash[SHA3_256_DIGEST_SIZE];
+    AptosSHA3::hash(data, length, hash);
+    return bytesToHex(hash, SHA3_256_DIGEST_SIZE);
+}
+
 String AptosUtils::serializeU8(uint8_t value) {
     return bytesToHex(&value, 1);
 }
 
 String AptosUtils::serializeU64(uint64_t value) {
     uint8_t bytes[8];
-    
-    // Little-endian encoding
-    for (int i = 0; i < 8; i++) {
-        bytes[i] = (value >> (i * 8)) & 0xFF;
-    }
-    
+    AptosBCSWriter writer(bytes, sizeof(bytes));
+    writer.writeU64(value);
     return bytesToHex(bytes, 8);
 }
 
 String AptosUtils::serializeString(const String& str) {
-    String result = serializeU64(str.length()); // Length prefix
-    
-    for (int i = 0; i < str.length(); i++) {
-        result += serializeU8((uint8_t)str.charAt(i));
+    AptosBCSWriter writer(str.length() + BCS_MAX_ULEB128_LENGTH);
+    if (!writer.writeString(str)) {
+        return "";
     }
-    
-    return result;
+    return writer.toHex();
 }
 
 String AptosUtils::serializeAddress(const String& address) {
-    String normalized = padHexAddress(address);
-    String cleanHex = removeHexPrefix(normalized);
-    
-    uint8_t bytes[32];
-    if (hexToBytes(cleanHex, bytes, 32)) {
-        return bytesToHex(bytes, 32);
+    uint8_t bytes[BCS_ADDRESS_LENGTH];
+    AptosBCSWriter writer(bytes, sizeof(bytes));
+    if (!writer.writeAddress(address)) {
+        return "";
     }
-    
-    return "";
+    return bytesToHex(bytes, BCS_ADDRESS_LENGTH);
 }
 
 String AptosUtils::serializeVector(const JsonArray& array) {
-    String result = serializeU64(array.size()); // Length prefix
+    AptosBCSWriter writer;
+    writer.writeVectorLength(array.size());
     
     for (JsonVariant item : array) {
-        if (item.is<String>()) {
-            result += serializeString(item.as<String>());
-        } else if (item.is<int>()) {
-            result += serializeU64(item.as<uint64_t>());
+        if (item.is<const char*>()) {
+            writer.writeString(item.as<const char*>());
+        } else if (item.is<uint64_t>()) {
+            writer.writeU64(item.as<uint64_t>());
         }
         // Add more types as needed
     }
     
-    return result;
+    if (!writer.ok()) {
+        return "";
+    }
+    return writer.toHex();
 }
 
 uint64_t AptosUtils::getCurrentTimestamp() {
-    // Return current time in seconds since epoch
-    // For ESP32, you might need to use NTP or RTC
+    // Return current time in seconds since epoch, once NTP (configTime) or
+    // the host clock has set it
+    time_t now = time(nullptr);
+    if (now > 1640995200) {
+        return (uint64_t)now;
+    }
+    // Clock not set yet
     return millis() / 1000 + 1640995200; // Approximate timestamp
 }
 
 String AptosUtils::generateTransactionHash(const JsonDocument& transaction) {
-    String txnString;
-    serializeJson(transaction, txnString);
-    return sha256Hash(txnString);
+    // Digest of the JSON form, streamed without building a String. Only the
+    // BCS overload below matches the hash the node reports.
+    AptosSHA3 hasher;
+    SHA3Print sink(hasher);
+    serializeJson(transaction, sink);
+    
+    uint8_t hash[SHA3_256_DIGEST_SIZE];
+    hasher.finish(hash);
+    return "0x" + bytesToHex(hash, SHA3_256_DIGEST_SIZE);
+}
+
+String AptosUtils::generateTransactionHash(const uint8_t* signedTxn, size_t length) {
+    uint8_t hash[SHA3_256_DIGEST_SIZE];
+    AptosTransaction::hashSignedTransaction(signedTxn, length, hash);
+    return "0x" + bytesToHex(hash, SHA3_256_DIGEST_SIZE);
 }
 
 bool AptosUtils::isValidUrl(const String& url) {
@@ -285,12 +488,5 @@ char AptosUtils::nibbleToHex(uint8_t nibble) {
 }
 
 uint8_t AptosUtils::hexToNibble(char hex) {
-    if (hex >= '0' && hex <= '9') {
-        return hex - '0';
-    } else if (hex >= 'a' && hex <= 'f') {
-        return hex - 'a' + 10;
-    } else if (hex >= 'A' && hex <= 'F') {
-        return hex - 'A' + 10;
-    }
-    return 0xFF; // Invalid character
+    return hexValues[(uint8_t)hex]; // 0xFF for an invalid character
 }
@@ -5,13 +5,24 @@
 #include <ArduinoJson.h>
 #include <mbedtls/sha256.h>
 #include <mbedtls/base64.h>
+#include "AptosBCS.h"
 
 class AptosUtils {
 public:
     // Hex conversion utilities
+    // Buffer forms: out holds 2 * length + 1 characters (lowercase, NUL
+    // terminated); decodeHex takes an optional 0x prefix and fails on odd
+    // lengths, invalid digits and more than maxLength bytes. No allocation.
+    static size_t encodeHex(const uint8_t* bytes, size_t length, char* out);
+    static bool decodeHex(const char* hex, size_t hexLength, uint8_t* out, size_t maxLength,
+                          size_t* written = nullptr);
+    static uint8_t hexValue(char c);   // 0xFF if c is not a hex digit
     static String bytesToHex(const uint8_t* bytes, size_t length);
     static bool hexToBytes(const String& hex, uint8_t* bytes, size_t maxLength);
     static String toHexString(uint64_t value);
+    static String toDecimalString(uint64_t value);
+    // u64 fields arrive as decimal strings ("123"), occasionally as numbers
+    static uint64_t jsonUint64(JsonVariantConst value);
     
     // Base64 utilities
     static String bytesToBase64(const uint8_t* bytes, size_t length);
@@ -25,8 +36,9 @@ public:
     // Hash utilities
     static String sha256Hash(const String& input);
     static String sha256Hash(const uint8_t* data, size_t length);
+    static String sha3_256Hash(const uint8_t* data, size_t length);
     
-    // BCS (Binary Canonical Serialization) utilities
+    // BCS (Binary Canonical Serialization) utilities, hex-encoded (see AptosBCSWriter)
     static String serializeU8(uint8_t value);
     static String serializeU64(uint64_t value);
     static String serializeString(const String& str);
@@ -36,6 +48,7 @@ public:
     // Transaction utilities
     static uint64_t getCurrentTimestamp();
     static String generateTransactionHash(const JsonDocument& transaction);
+    static String generateTransactionHash(const uint8_t* signedTxn, size_t length);
     
     // Network utilities
     static bool isValidUrl(const String& url);